@@ -378,14 +378,6 @@ static void cdc_txonly(usbd_device *dev, uint8_t event, uint8_t ep) {
     }
 }
 
-static void cdc_rxtx(usbd_device *dev, uint8_t event, uint8_t ep) {
-    if (event == usbd_evt_eptx) {
-        cdc_txonly(dev, event, ep);
-    } else {
-        cdc_rxonly(dev, event, ep);
-    }
-}
-
 /* HID mouse IN endpoint callback */
 static void hid_mouse_move(usbd_device *dev, uint8_t event, uint8_t ep) {
     static uint8_t t = 0;
@@ -458,9 +450,6 @@ static usbd_respond cdc_setconf (usbd_device *dev, uint8_t cfg) {
 #if defined(CDC_LOOPBACK)
         usbd_reg_endpoint(dev, CDC_RXD_EP, cdc_loopback);
         usbd_reg_endpoint(dev, CDC_TXD_EP, cdc_loopback);
-#elif ((CDC_TXD_EP & 0x7F) == (CDC_RXD_EP & 0x7F))
-        usbd_reg_endpoint(dev, CDC_RXD_EP, cdc_rxtx);
-        usbd_reg_endpoint(dev, CDC_TXD_EP, cdc_rxtx);
 #else
         usbd_reg_endpoint(dev, CDC_RXD_EP, cdc_rxonly);
         usbd_reg_endpoint(dev, CDC_TXD_EP, cdc_txonly);
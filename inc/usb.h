@@ -93,6 +93,8 @@
     #define USBD_STM32F429HS
 
     #if !defined(__ASSEMBLER__)
+    /* Both OTG cores can be used at the same time. Initialize separate usbd_device
+     * with usbd_otgfs and usbd_otghs and poll each of them from it's own IRQ handler */
     extern const struct usbd_driver usbd_otgfs;
     extern const struct usbd_driver usbd_otghs;
     #if defined(USBD_PRIMARY_OTGHS)
@@ -115,6 +117,8 @@
     #define USBD_STM32F446HS
 
     #if !defined(__ASSEMBLER__)
+    /* Both OTG cores can be used at the same time. Initialize separate usbd_device
+     * with usbd_otgfs and usbd_otghs and poll each of them from it's own IRQ handler */
     extern const struct usbd_driver usbd_otgfs;
     extern const struct usbd_driver usbd_otghs;
     #if defined(USBD_PRIMARY_OTGHS)
@@ -121,11 +121,13 @@ extern "C" {
 #define USB_DTYPE_INTERFACE         0x04    /**<\brief Interface descriptor.*/
 #define USB_DTYPE_ENDPOINT          0x05    /**<\brief Endpoint  descriptor.*/
 #define USB_DTYPE_QUALIFIER         0x06    /**<\brief Qualifier descriptor.*/
-#define USB_DTYPE_OTHER             0x07    /**<\brief Descriptor is of other type. */
+#define USB_DTYPE_OTHER             0x07    /**<\brief Other speed configuration descriptor. */
 #define USB_DTYPE_INTERFACEPOWER    0x08    /**<\brief Interface power descriptor. */
 #define USB_DTYPE_OTG               0x09    /**<\brief OTG descriptor.*/
 #define USB_DTYPE_DEBUG             0x0A    /**<\brief Debug descriptor.*/
 #define USB_DTYPE_INTERFASEASSOC    0x0B    /**<\brief Interface association descriptor.*/
+#define USB_DTYPE_BOS               0x0F    /**<\brief Binary device object store descriptor.*/
+#define USB_DTYPE_DEVCAP            0x10    /**<\brief Device capability descriptor.*/
 #define USB_DTYPE_CS_INTERFACE      0x24    /**<\brief Class specific interface descriptor.*/
 #define USB_DTYPE_CS_ENDPOINT       0x25    /**<\brief Class specific endpoint descriptor.*/
 /** @} */
@@ -169,6 +171,21 @@ extern "C" {
 #define USB_TEST_FORCE_ENABLE       0x05    /**<\brief Test Force Enable.*/
 /** @} */
 
+/**\name USB device capability types
+ * @{ */
+#define USB_DEVCAP_USB20EXT         0x02    /**<\brief USB 2.0 extension.*/
+/** @} */
+
+/**\name USB 2.0 extension capability attributes
+ * @{ */
+#define USB_USB20EXT_LPM            (1 << 1)    /**<\brief Link power management supported.*/
+#define USB_USB20EXT_BESL           (1 << 2)    /**<\brief BESL and alternate HIRD definitions are used.*/
+#define USB_USB20EXT_BBESL_VALID    (1 << 3)    /**<\brief Baseline BESL field is valid.*/
+#define USB_USB20EXT_DBESL_VALID    (1 << 4)    /**<\brief Deep BESL field is valid.*/
+#define USB_USB20EXT_BBESL(besl)    (((besl) & 0x0F) << 8)  /**<\brief Recommended baseline BESL.*/
+#define USB_USB20EXT_DBESL(besl)    (((besl) & 0x0F) << 12) /**<\brief Recommended deep BESL.*/
+/** @} */
+
 /** \addtogroup USB_STD_LANGID USB standard LANGID codes
  * @{ */
 #define USB_LANGID_AFR              0x0436   /**<\brief Afrikaans */
@@ -452,6 +469,26 @@ struct usb_debug_descriptor {
     uint8_t  bDebugOutEndpoint;     /**<\brief Endpoint number of the Debug Data OUTendpoint.*/
 } __attribute__((packed));
 
+/**\brief USB binary device object store (BOS) descriptor
+ * \details BOS descriptor is a root of the device capability descriptors. It's requested by the
+ * host if bcdUSB in the device descriptor is 0x0201 or above.*/
+struct usb_bos_descriptor {
+    uint8_t  bLength;               /**<\brief Size of the descriptor, in bytes.*/
+    uint8_t  bDescriptorType;       /**<\brief BOS descriptor type.*/
+    uint16_t wTotalLength;          /**<\brief Size of the BOS descriptor and all device capability
+                                     * descriptors. */
+    uint8_t  bNumDeviceCaps;        /**<\brief Number of the device capability descriptors.*/
+} __attribute__((packed));
+
+/**\brief USB 2.0 extension device capability descriptor
+ * \details Describes link power management (LPM) capabilities of the device.*/
+struct usb_usb20ext_descriptor {
+    uint8_t  bLength;               /**<\brief Size of the descriptor, in bytes.*/
+    uint8_t  bDescriptorType;       /**<\brief Device capability descriptor type.*/
+    uint8_t  bDevCapabilityType;    /**<\brief \ref USB_DEVCAP_USB20EXT capability type.*/
+    uint32_t bmAttributes;          /**<\brief USB 2.0 extension capability attributes.*/
+} __attribute__((packed));
+
 /** @} */
 
 #if defined (__cplusplus)
@@ -31,7 +31,49 @@
 #define USBD_DP_PIN         /**<\brief DP pullup pin for F103/F303 driver.*/
 #define USBD_SOF_OUT        /**<\brief Enables SOF output pin for F4 OTGFS. */
 #define USBD_PRIMARY_OTGHS  /**<\brief Sets OTGHS as primary interface for F4*/
-#define USBD_USE_EXT_ULPI   /**<\brief Enables external ULPI interface for OTGHS */
+#define USBD_USE_EXT_ULPI   /**<\brief Enables external ULPI high-speed PHY for F4x6/F7 OTGHS.
+                              * ULPI pins must be configured by the user.*/
+#define USBD_MAX_INTERFACES /**<\brief Number of the interfaces which alternate settings are
+                              * tracked by core. 8 by default.*/
+#define USBD_MAX_EP         /**<\brief Endpoints 1 to USBD_MAX_EP-1 can have callbacks. 8 by
+                              * default, up to 16. 1 removes the endpoint callback table.*/
+#define USBD_MAX_EVENTS     /**<\brief Events 0 to USBD_MAX_EVENTS-1 can have callbacks. All
+                              * events by default. 4 keeps bus events (reset, SOF, suspend and
+                              * wakeup), 0 removes the event callback table.*/
+#define USBD_STREAM_DISABLED /**<\brief Removes control data streaming. Control requests with
+                              * the payload larger than the control buffer are stalled.*/
+#define USBD_DUAL_SPEED     /**<\brief Enables device qualifier and other speed configuration
+                              * descriptors. Descriptors and endpoints are described for full
+                              * speed and converted by core when enumerated at high speed.
+                              * EP0 size must be 64 bytes.*/
+#define USBD_FIFO_MAX_TX     /**<\brief Number of the TX FIFO entries in \ref usbd_fifo_plan.
+                              * 9 by default.*/
+#define USBD_HCLK           /**<\brief Core clock in Hz for the OTG RESUME busy-wait. Maximum
+                              * clock of the family by default, which makes RESUME longer at
+                              * lower clocks. Set it to the actual core clock.*/
+#define USBD_SUSPEND_LOWPOWER /**<\brief Enables USB low-power mode (devfs LPMODE, OTG PHY
+                              * clock stop) when bus is suspended.*/
+#define USBD_SPLIT_ISR      /**<\brief Splits event processing. USB interrupt handles data
+                              * endpoints and EP0 packets only. Control requests and bus event
+                              * callbacks are deferred to \ref usbd_process_pending. Their
+                              * results are applied by \ref usbd_poll, so EP0 is driven by USB
+                              * interrupt only.*/
+#define USBD_EVENT_QUEUE    /**<\brief Enables event queue mode. User event and data endpoint
+                              * callbacks are called from \ref usbd_process_queue in the thread
+                              * context instead of USB interrupt.*/
+#define USBD_EVENT_QUEUE_SIZE /**<\brief Event queue length. Power of two up to 128. 16 by
+                              * default.*/
+#define USBD_EVENT_QUEUE_WFE /**<\brief Enables \ref usbd_queue_wait. USB interrupt signals
+                              * the event by SEV.*/
+#define USBD_OSAL           /**<\brief Enables OS abstraction layer and blocking endpoint I/O.
+                              * See usbd_osal.h.*/
+#define USBD_OSAL_PTHREAD   /**<\brief Builds POSIX threads OS abstraction.*/
+#define USBD_TRACE          /**<\brief Enables trace of the events, control stage transitions and
+                              * endpoint I/O to the \ref usbd_trace RAM ring.*/
+#define USBD_TRACE_SIZE     /**<\brief Trace ring length in records. Power of two. 256 by
+                              * default.*/
+#define USBD_TRACE_CLOCK()  /**<\brief Trace timestamp source. DWT cycle counter for
+                              * ARMv7-M/ARMv8-M mainline, SysTick elapsed ticks otherwise.*/
 #define USB_PMA_SIZE        /**<\brief PMA memoty size in bytes. Adjust this for
                               * the devices that shares PMA memory with CAN in case
                               * of both USB and CAN in use to avoid data corruption. */
@@ -52,9 +94,24 @@
 #define usbd_evt_eprx       5   /**<\brief Data packet received.*/
 #define usbd_evt_epsetup    6   /**<\brief Setup packet received.*/
 #define usbd_evt_error      7   /**<\brief Data error.*/
-#define usbd_evt_count      8
+#define usbd_evt_l1susp     8   /**<\brief LPM L1 sleep.*/
+#define usbd_evt_l1wkup     9   /**<\brief LPM L1 resume.*/
+#define usbd_evt_isoinc     10  /**<\brief Isochronous transfer missed it's frame. Stale IN data
+                                 * is dropped, next frame payload should be written as on
+                                 * \ref usbd_evt_eptx. OTG drivers only.*/
+#define usbd_evt_count      11
 /** @}*/
 
+/**\anchor USBD_DEV_STATUS
+ * \name USB device status flags
+ * @{ */
+#define USBD_STATUS_SELFPWR (1 << 0)    /**<\brief Device is self-powered.*/
+#define USBD_STATUS_RWAKEUP (1 << 1)    /**<\brief Remote wakeup enabled by host.*/
+#define USBD_STATUS_LPM     (1 << 2)    /**<\brief LPM enabled and advertised in BOS.*/
+#define USBD_STATUS_L1SLEEP (1 << 6)    /**<\brief USB link is in LPM L1 sleep state.*/
+#define USBD_STATUS_SUSPEND (1 << 7)    /**<\brief USB bus is suspended.*/
+/** @} */
+
 /**\anchor USB_LANES_STATUS
  * \name USB lanes connection states
  * @{ */
@@ -70,7 +127,8 @@
  * @{ */
 #define USBD_HW_ADDRFST     (1 << 0)    /**<\brief Set address before STATUS_OUT.*/
 #define USBD_HW_BC          (1 << 1)    /**<\brief Battery charging detection supported.*/
-#define USND_HW_HS          (1 << 2)    /**<\brief High speed supported.*/
+#define USBD_HW_HS          (1 << 2)    /**<\brief High speed supported.*/
+#define USND_HW_HS          USBD_HW_HS  /**<\brief \deprecated Use \ref USBD_HW_HS.*/
 #define USBD_HW_ENABLED     (1 << 3)    /**<\brief USB device enabled. */
 #define USBD_HW_ENUMSPEED   (3 << 4)    /**<\brief USB device enumeration speed mask.*/
 #define USBD_HW_SPEED_NC    (0 << 4)    /**<\brief Not connected */
@@ -103,6 +161,48 @@
 /** @} */
 
 
+#if !defined(USBD_MAX_INTERFACES)
+#define USBD_MAX_INTERFACES 8
+#endif
+
+#if !defined(USBD_MAX_EP)
+#define USBD_MAX_EP         8
+#elif (USBD_MAX_EP < 1) || (USBD_MAX_EP > 16)
+#error USBD_MAX_EP must be in range 1 to 16
+#endif
+
+#if !defined(USBD_MAX_EVENTS)
+#define USBD_MAX_EVENTS     usbd_evt_count
+#elif (USBD_MAX_EVENTS < 0) || (USBD_MAX_EVENTS > usbd_evt_count)
+#error USBD_MAX_EVENTS must be in range 0 to usbd_evt_count
+#endif
+
+#if !defined(USBD_FIFO_MAX_TX)
+#define USBD_FIFO_MAX_TX    9
+#endif
+
+#if !defined(USBD_EVENT_QUEUE_SIZE)
+#define USBD_EVENT_QUEUE_SIZE   16
+#elif (USBD_EVENT_QUEUE_SIZE > 128) || (USBD_EVENT_QUEUE_SIZE & (USBD_EVENT_QUEUE_SIZE - 1))
+#error USBD_EVENT_QUEUE_SIZE must be power of two up to 128
+#endif
+
+#if !defined(USBD_TRACE_SIZE)
+#define USBD_TRACE_SIZE     256
+#elif (USBD_TRACE_SIZE & (USBD_TRACE_SIZE - 1))
+#error USBD_TRACE_SIZE must be power of two
+#endif
+
+#if !defined(USBD_TRACE_CLOCK)
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+/* DWT CYCCNT */
+#define USBD_TRACE_CLOCK()  (*(volatile uint32_t*)0xE0001004)
+#else
+/* SysTick VAL is a down counter. valid for the deltas within reload period */
+#define USBD_TRACE_CLOCK()  (0 - *(volatile uint32_t*)0xE000E018)
+#endif
+#endif
+
 #if !defined(__ASSEMBLER__)
 #include <stdbool.h>
 #include <stddef.h>
@@ -127,17 +227,74 @@ enum usbd_ctl_state {
                                  * for the TX completion.*/
     usbd_ctl_statusin,          /**<\brief STATUS-IN stage.*/
     usbd_ctl_statusout,         /**<\brief STATUS-OUT stage.*/
+    usbd_ctl_deferred,          /**<\brief Request processing deferred by usbd_nak. EP0 NAKs until
+                                 * \ref usbd_ctl_complete or \ref usbd_ctl_stall call.*/
 };
 
 /**\brief Reporting status results.*/
 typedef enum _usbd_respond {
     usbd_fail,                  /**<\brief Function has an error, STALLPID will be issued.*/
     usbd_ack,                   /**<\brief Function completes request accepted ZLP or data will be send.*/
-    usbd_nak,                   /**<\brief Function is busy. NAK handshake.*/
+    usbd_nak,                   /**<\brief Function is busy. NAK handshake. Request must be
+                                 * finished later by \ref usbd_ctl_complete or \ref usbd_ctl_stall.*/
 } usbd_respond;
 
 typedef struct _usbd_device usbd_device;
 
+#if defined(USBD_TRACE) || defined(__DOXYGEN__)
+/**\anchor USBD_TRACE_TYPES
+ * \name Trace record types
+ * @{ */
+#define USBD_TRACE_MAGIC    0x43525455  /**<\brief "UTRC". Marks trace ring in the RAM dump.*/
+#define USBD_TRACE_EVT      1   /**<\brief Driver event. arg is event | (control state << 8).*/
+#define USBD_TRACE_CTL      2   /**<\brief Control stage after EP0 event. arg is control state.*/
+#define USBD_TRACE_RD       3   /**<\brief Endpoint read. arg is result.*/
+#define USBD_TRACE_WR       4   /**<\brief Endpoint write. arg is result.*/
+/** @} */
+
+/**\brief Trace record */
+typedef struct {
+    uint32_t    tick;           /**<\brief \ref USBD_TRACE_CLOCK timestamp.*/
+    uint8_t     type;           /**<\brief \ref USBD_TRACE_TYPES "Record type".*/
+    uint8_t     ep;             /**<\brief Endpoint number.*/
+    uint16_t    arg;            /**<\brief Type specific argument.*/
+} usbd_trace_rec;
+
+/**\brief Trace ring
+ * \details Layout is fixed for the host side decoder (tools/usbd_trace.py).*/
+typedef struct {
+    uint32_t            magic;  /**<\brief \ref USBD_TRACE_MAGIC.*/
+    uint32_t            size;   /**<\brief Ring length in records.*/
+    volatile uint32_t   head;   /**<\brief Free running write counter.*/
+    usbd_trace_rec      rec[USBD_TRACE_SIZE]; /**<\brief Trace records.*/
+} usbd_trace_ring;
+
+/**\brief Trace ring storage */
+extern usbd_trace_ring usbd_trace;
+
+/**\brief Adds trace record
+ * \note Records added from the preempting contexts at the same time may be lost.
+ */
+inline static void usbd_trace_add(uint8_t type, uint8_t ep, uint16_t arg) {
+    usbd_trace_rec *const r = &usbd_trace.rec[usbd_trace.head++ & (USBD_TRACE_SIZE - 1)];
+    r->tick = USBD_TRACE_CLOCK();
+    r->type = type;
+    r->ep = ep;
+    r->arg = arg;
+}
+
+/**\brief Enables DWT cycle counter used as a trace timestamp on ARMv7-M/ARMv8-M mainline */
+inline static void usbd_trace_start(void) {
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_8M_MAIN__)
+    *(volatile uint32_t*)0xE000EDFC |= (1 << 24);   /* DEMCR TRCENA */
+    *(volatile uint32_t*)0xE0001000 |= (1 << 0);    /* DWT_CTRL CYCCNTENA */
+#endif
+}
+#define USBD_TRACE_ADD(type, ep, arg)   usbd_trace_add((type), (ep), (arg))
+#else
+#define USBD_TRACE_ADD(type, ep, arg)
+#endif
+
 /**\brief Represents generic USB control request.*/
 typedef struct {
     uint8_t     bmRequestType;  /**<\brief This bitmapped field identifies the characteristics of
@@ -158,20 +315,80 @@ typedef struct {
              void        *data_ptr;      /**<\brief Pointer to current data for control request.*/
              uint16_t    data_count;     /**<\brief Count remained data for control request.*/
              uint16_t    data_maxsize;   /**<\brief Size of the data buffer for control requests.*/
+#if !defined(USBD_STREAM_DISABLED) || defined(__DOXYGEN__)
+             uint16_t    data_offset;    /**<\brief Offset of the current DATA-IN chunk in streaming mode.*/
+#endif
              uint8_t     ep0size;        /**<\brief Size of the control endpoint.*/
              uint8_t     device_cfg;     /**<\brief Current device configuration number.*/
     volatile uint8_t     device_state;   /**<\brief Current \ref usbd_machine_state.*/
              uint8_t     control_state;  /**<\brief Current \ref usbd_ctl_state.*/
+    volatile uint8_t     device_status;  /**<\brief Current \ref USBD_DEV_STATUS "device status".*/
+             uint8_t     lpm_besl;       /**<\brief Recommended LPM baseline (bits 3:0) and deep
+                                          * (bits 7:4) BESL values.*/
+             uint8_t     alt_setting[USBD_MAX_INTERFACES]; /**<\brief Current alternate settings
+                                                            * for the interfaces.*/
 } usbd_status;
 
+#if defined(USBD_EVENT_QUEUE) || defined(__DOXYGEN__)
+/**\brief Queued event record */
+typedef struct {
+    uint8_t     evt;            /**<\brief \ref USB_EVENTS "USB event".*/
+    uint8_t     ep;             /**<\brief Active endpoint number.*/
+    uint16_t    len;            /**<\brief Size of the received packet for the \ref usbd_evt_eprx
+                                 * and \ref usbd_evt_epsetup events on the data endpoints. Taken
+                                 * by \ref usbd_hw_ep_peek when the event is queued. 0 for the
+                                 * other events or if driver has no peek.*/
+} usbd_evt_record;
+
+/**\brief Event queue
+ * \details Single producer (USB interrupt), single consumer (\ref usbd_process_queue) ring.
+ * Head and tail are free running counters.
+ */
+typedef struct {
+    volatile uint8_t     head;       /**<\brief Write counter. Updated by USB interrupt.*/
+    volatile uint8_t     tail;       /**<\brief Read counter. Updated by consumer.*/
+    volatile uint16_t    overflow;   /**<\brief Events that didn't fit to the queue. These events
+                                      * are latched to the pending bits and dispatched by
+                                      * \ref usbd_process_queue after the queued ones. Repeated
+                                      * event is coalesced while pending.*/
+    volatile uint16_t    pend_set;   /**<\brief Pending non endpoint events. Bit per event.
+                                      * Toggled by USB interrupt.*/
+    volatile uint16_t    pend_ack;   /**<\brief Pending non endpoint events acknowledged by
+                                      * \ref usbd_process_queue.*/
+    volatile uint32_t    pend_ep_set[4]; /**<\brief Pending \ref usbd_evt_eptx, \ref usbd_evt_eprx,
+                                      * \ref usbd_evt_epsetup and \ref usbd_evt_isoinc events.
+                                      * Bit per endpoint, IN endpoints in the high half. Toggled by
+                                      * USB interrupt.*/
+    volatile uint32_t    pend_ep_ack[4]; /**<\brief Pending endpoint events acknowledged by
+                                      * \ref usbd_process_queue.*/
+             uint16_t    len;        /**<\brief \ref usbd_evt_record::len of the event that is
+                                      * dispatched by \ref usbd_process_queue. Valid in its
+                                      * callbacks only.*/
+    volatile usbd_evt_record evt[USBD_EVENT_QUEUE_SIZE]; /**<\brief Queued events.*/
+} usbd_evt_queue;
+#endif
+
 /**\brief Generic USB device event callback for events and endpoints processing
   * \param[in] dev pointer to USB device
   * \param event \ref USB_EVENTS "USB event"
   * \param ep active endpoint number
-  * \note endpoints with same indexes i.e. 0x01 and 0x81 shares same callback.
+  * \note endpoint callback is called for its direction only. OUT endpoint callback gets
+  * \ref usbd_evt_eprx, \ref usbd_evt_epsetup and OUT \ref usbd_evt_isoinc events, IN endpoint
+  * callback gets \ref usbd_evt_eptx and IN \ref usbd_evt_isoinc events.
   */
 typedef void (*usbd_evt_callback)(usbd_device *dev, uint8_t event, uint8_t ep);
 
+#if defined(USBD_SPLIT_ISR) || defined(__DOXYGEN__)
+/**\brief Deferred work notification callback
+ * \details Kick callback is called from the USB interrupt when control request or bus event is
+ * latched for the \ref usbd_process_pending. Typically sets PendSV or signals the main loop.
+ * IRQ callback is called when control request result is latched for the \ref usbd_poll.
+ * Typically pends USB interrupt by NVIC_SetPendingIRQ.
+ * \param[in] dev pointer to USB device
+ */
+typedef void (*usbd_kick_callback)(usbd_device *dev);
+#endif
+
 /**\brief USB control transfer completed callback function.
  * \param[in] dev pointer to USB device
  * \param[in] req pointer to usb request structure
@@ -187,8 +404,10 @@ typedef void (*usbd_rqc_callback)(usbd_device *dev, usbd_ctlreq *req);
  *          - SET_CONFIGURATION (passes to \ref usbd_cfg_callback)
  *          - GET_DESCRIPTOR (passes to \ref usbd_dsc_callback)
  *          - GET_STATUS
- *          - SET_FEATURE, CLEAR_FEATURE (endpoints only)
+ *          - SET_FEATURE, CLEAR_FEATURE (endpoints and device remote wakeup)
  *          - SET_ADDRESS
+ *          - SET_INTERFACE (passes to \ref usbd_ifc_callback)
+ *          - GET_INTERFACE
  * \param[in] dev points to USB device
  * \param[in] req points to usb control request
  * \param[out] *callback USB control transfer completion callback, default is NULL (no callback)
@@ -215,6 +434,36 @@ typedef usbd_respond (*usbd_dsc_callback)(usbd_ctlreq *req, void **address, uint
  */
 typedef usbd_respond (*usbd_cfg_callback)(usbd_device *dev, uint8_t cfg);
 
+/**\brief USB set interface callback function
+ * \details called when SET_INTERFACE request issued. Endpoints of the previous alternate setting
+ * should be de-configured and endpoints of the new one configured inside this callback. The STATUS
+ * stage will be completed after the callback returns, so the host never sees a half-configured
+ * interface.
+ * \param[in] dev pointer to USB device
+ * \param[in] iface interface number.
+ * \param[in] altsetting alternate setting number.
+ * \note Keep the alternate setting 0 free of the isochronous endpoints to release the periodic
+ * bandwidth while the interface is idle.
+ * \note If callback is not registered only alternate setting 0 will be accepted.
+ * \return usbd_ack if success
+ */
+typedef usbd_respond (*usbd_ifc_callback)(usbd_device *dev, uint8_t iface, uint8_t altsetting);
+
+/**\brief USB control data streaming callback
+ * \details Used for the control requests which payload doesn't fit into the control data buffer.
+ * Payload is passed one EP0 packet at a time through req->data, so the buffer needs to fit only
+ * the request header and a single EP0 packet.
+ * - DATA-OUT stage of the request with wLength above the buffer size. Callback called for every
+ * received packet. After the last packet control callback will be called as usual.
+ * - DATA-IN stage started by \ref usbd_ctl_stream. Callback must fill req->data with the next chunk.
+ * \param[in] dev pointer to USB device
+ * \param[in,out] req pointer to usb control request. Chunk data is placed to req->data.
+ * \param[in] offset offset of the chunk in DATA stage.
+ * \param[in] blen size of the chunk.
+ * \return usbd_ack to continue, usbd_fail to abort request with STALL PID.
+ */
+typedef usbd_respond (*usbd_ctl_stream_callback)(usbd_device *dev, usbd_ctlreq *req, uint16_t offset, uint16_t blen);
+
 /** @} */
 
 /**\addtogroup USBD_HW
@@ -290,6 +539,14 @@ typedef void (*usbd_hw_ep_setstall)(uint8_t ep, bool stall);
  */
 typedef bool (*usbd_hw_ep_isstalled)(uint8_t ep);
 
+/**\brief Gets size of the received packet without reading it
+ * \param ep endpoint address
+ * \return size of the packet that will be read by the next \ref usbd_hw_ep_read, -1 if there is
+ * no received data.
+ * \note Endpoint state is left intact. It's used to fill \ref usbd_evt_record::len.
+ */
+typedef int32_t (*usbd_hw_ep_peek)(uint8_t ep);
+
 /**\brief Polls USB hardware for the events
  * \param[in] dev pointer to usb device structure
  * \param callback callback to event processing subroutine
@@ -300,12 +557,55 @@ typedef void (*usbd_hw_poll)(usbd_device *dev, usbd_evt_callback callback);
 typedef uint16_t (*usbd_hw_get_frameno)(void);
 
 
+/**\brief Size of the serial number string descriptor made by \ref usbd_hw_get_serialno.*/
+#define USBD_SERIALNO_SIZE      18
+
 /**\brief Makes a string descriptor contains unique serial number from hardware ID's
  * \param[in] buffer pointer to buffer for the descriptor
  * \return of the descriptor in bytes
  */
 typedef uint16_t (*usbd_hw_get_serialno)(void *buffer);
 
+/**\brief Starts RESUME signaling on the suspended bus.
+ * \note Hardware driver is responsible for the RESUME duration (1-15ms). OTG drivers block for
+ * it in a busy-wait loop counted from \ref USBD_HCLK.
+ * \return TRUE if RESUME signaling was started. FALSE if the host didn't allow remote wakeup
+ * from L1 sleep. Suspend state is left intact in this case.
+ */
+typedef bool (*usbd_hw_remote_wakeup)(void);
+
+/**\brief Enables or disables USB 2.0 link power management (LPM)
+ * \param enable Enables LPM L1 sleep requests acknowledgement if TRUE, disables otherwise
+ * \param besl BESL threshold for the deep low-power mode in L1 state. Not used by devfs.
+ */
+typedef void (*usbd_hw_lpm_config)(bool enable, uint8_t besl);
+
+/**\brief Represents a single FIFO of the \ref usbd_fifo_plan */
+struct usbd_fifo_entry {
+    uint16_t    packet;         /**<\brief Maximum packet size in bytes.*/
+    uint8_t     depth;          /**<\brief FIFO depth in packets. 0 if FIFO is not used.*/
+    uint16_t    start;          /**<\brief FIFO start address in 32-bit words. Computed by driver.*/
+    uint16_t    words;          /**<\brief FIFO size in 32-bit words. Computed by driver.*/
+};
+
+/**\brief Represents OTG FIFO RAM partitioning plan
+ * \details Application sets packet sizes and depths. Driver validates the plan, computes FIFO
+ * layout and reports it back in the start and words fields.
+ */
+struct usbd_fifo_plan {
+    struct usbd_fifo_entry  rx;                     /**<\brief Shared RX FIFO.*/
+    struct usbd_fifo_entry  tx[USBD_FIFO_MAX_TX];   /**<\brief TX FIFOs for IN endpoints 0 .. N.*/
+    uint16_t                ram_words;              /**<\brief Total FIFO RAM in 32-bit words.
+                                                     * Reported by driver.*/
+};
+
+/**\brief Applies FIFO RAM partitioning plan
+ * \param plan pointer to the FIFO plan. NULL restores default greedy allocation.
+ * \return TRUE if plan fits the FIFO RAM and applied.
+ * \note IN endpoints configured with the plan applied must have a TX FIFO in the plan.
+ */
+typedef bool (*usbd_hw_fifo_plan)(struct usbd_fifo_plan *plan);
+
 /**\brief Represents a hardware USB driver call table.*/
 struct usbd_driver {
     usbd_hw_getinfo         getinfo;            /**<\copybrief usbd_hw_getinfo */
@@ -321,6 +621,10 @@ struct usbd_driver {
     usbd_hw_poll            poll;               /**<\copybrief usbd_hw_poll */
     usbd_hw_get_frameno     frame_no;           /**<\copybrief usbd_hw_get_frameno */
     usbd_hw_get_serialno    get_serialno_desc;  /**<\copybrief usbd_hw_get_serialno */
+    usbd_hw_remote_wakeup   remote_wakeup;      /**<\copybrief usbd_hw_remote_wakeup */
+    usbd_hw_lpm_config      lpm_config;         /**<\copybrief usbd_hw_lpm_config */
+    usbd_hw_fifo_plan       fifo_plan;          /**<\copybrief usbd_hw_fifo_plan */
+    usbd_hw_ep_peek         ep_peek;            /**<\copybrief usbd_hw_ep_peek */
 };
 
 /** @} */
@@ -328,6 +632,10 @@ struct usbd_driver {
 /**\addtogroup USBD_CORE
  * @{ */
 
+#if defined(USBD_OSAL) || defined(__DOXYGEN__)
+struct usbd_osal;
+#endif
+
 /**\brief Represents a USB device data.*/
 struct _usbd_device {
     const struct usbd_driver    *driver;                /**<\copybrief usbd_driver */
@@ -335,9 +643,51 @@ struct _usbd_device {
     usbd_rqc_callback           complete_callback;      /**<\copybrief usbd_rqc_callback */
     usbd_cfg_callback           config_callback;        /**<\copybrief usbd_cfg_callback */
     usbd_dsc_callback           descriptor_callback;    /**<\copybrief usbd_dsc_callback */
-    usbd_evt_callback           events[usbd_evt_count]; /**<\brief array of the event callbacks.*/
-    usbd_evt_callback           endpoint[8];            /**<\brief array of the endpoint callbacks.*/
+    usbd_ifc_callback           interface_callback;     /**<\copybrief usbd_ifc_callback */
+#if !defined(USBD_STREAM_DISABLED) || defined(__DOXYGEN__)
+    usbd_ctl_stream_callback    stream_callback;        /**<\copybrief usbd_ctl_stream_callback */
+#endif
+#if (USBD_MAX_EVENTS > 0) || defined(__DOXYGEN__)
+    usbd_evt_callback           events[USBD_MAX_EVENTS]; /**<\brief array of the event callbacks.*/
+#endif
+#if (USBD_MAX_EP > 1) || defined(__DOXYGEN__)
+    usbd_evt_callback           endpoint[2][USBD_MAX_EP - 1]; /**<\brief arrays of the OUT [0] and
+                                                         * IN [1] callbacks of the endpoints 1 to
+                                                         * USBD_MAX_EP-1. EP0 is handled by core.*/
+#endif
     usbd_status                 status;                 /**<\copybrief usbd_status */
+#if defined(USBD_SPLIT_ISR) || defined(__DOXYGEN__)
+    usbd_kick_callback          kick_callback;          /**<\copybrief usbd_kick_callback */
+    volatile uint16_t           pend_set;               /**<\brief Pending bits toggled by USB
+                                                         * interrupt.*/
+    volatile uint16_t           pend_ack;               /**<\brief Pending bits acknowledged by
+                                                         * \ref usbd_process_pending.*/
+    usbd_kick_callback          irq_callback;           /**<\brief USB interrupt pend callback.*/
+    volatile uint8_t            ctl_seq;                /**<\brief SETUP and reset counter.*/
+    volatile bool               ctl_busy;               /**<\brief Control buffer is owned by
+                                                         * the request handler.*/
+    volatile bool               ctl_parked;             /**<\brief SETUP is parked in the
+                                                         * \ref ctl_setup.*/
+    volatile uint8_t            rpl_seq;                /**<\brief \ref ctl_seq of the latched
+                                                         * request result.*/
+    volatile uint8_t            rpl_result;             /**<\brief Latched request result + 1.
+                                                         * 0 if none.*/
+    volatile uint16_t           rpl_len;                /**<\brief DATA-IN payload length of the
+                                                         * latched result.*/
+    const void *volatile        rpl_data;               /**<\brief DATA-IN payload of the latched
+                                                         * result.*/
+    uint32_t                    ctl_setup[2];           /**<\brief SETUP received while the
+                                                         * control buffer is owned by the
+                                                         * request handler.*/
+#endif
+#if defined(USBD_EVENT_QUEUE) || defined(__DOXYGEN__)
+    usbd_evt_queue              queue;                  /**<\copybrief usbd_evt_queue */
+#endif
+#if defined(USBD_OSAL) || defined(__DOXYGEN__)
+    const struct usbd_osal      *osal;                  /**<\brief OS abstraction call table.*/
+    void                        *osal_flags;            /**<\brief OS event flags object.*/
+    void                        *osal_sem;              /**<\brief OS semaphore object.*/
+#endif
 };
 
 /**\brief Initializes device structure
@@ -345,7 +695,9 @@ struct _usbd_device {
  * \param drv Pointer to hardware driver
  * \param ep0size Control endpoint 0 size
  * \param buffer Pointer to control request data buffer (32-bit aligned)
- * \param bsize Size of the data buffer
+ * \param bsize Size of the data buffer. 8 bytes of the request and at least 2 bytes of the payload
+ * for the standard requests. Descriptors built by the stack (serial number, BOS, device qualifier)
+ * are rejected if they don't fit.
  */
 inline static void usbd_init(usbd_device *dev, const struct usbd_driver *drv,
                              const uint8_t ep0size, uint32_t *buffer, const uint16_t bsize) {
@@ -362,6 +714,94 @@ inline static void usbd_init(usbd_device *dev, const struct usbd_driver *drv,
  */
 void usbd_poll(usbd_device *dev);
 
+#if defined(USBD_SPLIT_ISR) || defined(__DOXYGEN__)
+/**\brief Processes deferred control requests and bus event callbacks
+ * \details Control request result is latched back for the \ref usbd_poll that starts DATA or
+ * STATUS stage. SETUP received while the request handler runs is parked and handled next. Such
+ * SETUP is stalled if it has DATA OUT stage.
+ * \param dev Pointer to device structure
+ * \note Call it from the lower priority interrupt (i.e. PendSV) or main loop. USB interrupt must
+ * be able to preempt it. Several events of the same type latched before the call are reported
+ * once. Data endpoints accessed by the user callbacks from here must be guarded by application.
+ */
+void usbd_process_pending(usbd_device *dev);
+
+/**\brief Register deferred work notification callback
+ * \param dev usb device \ref _usbd_device
+ * \param callback pointer to user \ref usbd_kick_callback. NULL if \ref usbd_process_pending
+ * is polled from the main loop.
+ */
+inline static void usbd_reg_kick(usbd_device *dev, usbd_kick_callback callback) {
+    dev->kick_callback = callback;
+}
+
+/**\brief Register USB interrupt pend callback
+ * \param dev usb device \ref _usbd_device
+ * \param callback pointer to user \ref usbd_kick_callback that pends USB interrupt, so it starts
+ * DATA or STATUS stage of the handled control request. NULL if \ref usbd_poll is called from the
+ * main loop.
+ */
+inline static void usbd_reg_irq(usbd_device *dev, usbd_kick_callback callback) {
+    dev->irq_callback = callback;
+}
+#endif
+
+#if defined(USBD_EVENT_QUEUE) || defined(__DOXYGEN__)
+/**\brief Handles queued events
+ * \details Calls user event and data endpoint callbacks for the events that were queued before
+ * the call, then for the events that overflowed the queue. Callbacks may read and write
+ * endpoints. On the OTG cores unread OUT packet blocks RX FIFO for all endpoints until it's read.
+ * \param dev Pointer to device structure
+ * \return number of the handled events
+ * \note Must not be preempted by another usbd_process_queue call.
+ */
+uint8_t usbd_process_queue(usbd_device *dev);
+
+#if defined(USBD_EVENT_QUEUE_WFE) || defined(__DOXYGEN__)
+/**\brief Sleeps until event queue is not empty
+ * \param dev Pointer to device structure
+ */
+inline static void usbd_queue_wait(usbd_device *dev) {
+    while (dev->queue.head == dev->queue.tail) {
+        __asm__ volatile ("wfe");
+    }
+}
+#endif
+#endif
+
+/**\brief Wakes up the host from suspend
+ * \param dev Pointer to device structure
+ * \return TRUE if RESUME signaling was issued, FALSE if remote wakeup is not enabled by host,
+ * bus is not suspended or hardware doesn't support it.
+ * \note Blocks for the RESUME duration on OTG cores, see \ref USBD_HCLK.
+ */
+bool usbd_remote_wakeup(usbd_device *dev);
+
+/**\brief Completes deferred control request
+ * \details Finishes control request that was deferred by returning usbd_nak from
+ * \ref usbd_ctl_callback. Starts DATA-IN stage for the device-to-host requests or STATUS-IN stage
+ * otherwise.
+ * \param dev Pointer to device structure
+ * \param data Pointer to DATA-IN payload. NULL if payload was placed to req->data.
+ * Must be valid until transfer completion. Ignored for the host-to-device requests.
+ * \param len Size of the DATA-IN payload. Ignored for the host-to-device requests.
+ * \return TRUE if deferred request was completed, FALSE if no deferred request is pending (i.e.
+ * it was aborted by the host with a new SETUP).
+ * \note Must not race with \ref usbd_poll. Mask USB interrupt around the call if it's called
+ * from the thread context. With \ref USBD_SPLIT_ISR result is latched for the \ref usbd_poll, so
+ * it's safe to call from any context.
+ */
+bool usbd_ctl_complete(usbd_device *dev, const void *data, uint16_t len);
+
+/**\brief Rejects deferred control request with STALL PID
+ * \param dev Pointer to device structure
+ * \return TRUE if deferred request was rejected, FALSE if no deferred request is pending.
+ * \note Must not race with \ref usbd_poll. Mask USB interrupt around the call if it's called
+ * from the thread context. With \ref USBD_SPLIT_ISR result is latched for the \ref usbd_poll, so
+ * it's safe to call from any context.
+ */
+bool usbd_ctl_stall(usbd_device *dev);
+
 /**\brief Register callback for all control requests
  * \param dev usb device \ref _usbd_device
  * \param callback user control callback \ref usbd_ctl_callback
@@ -386,11 +826,60 @@ inline static void usbd_reg_descr(usbd_device *dev, usbd_dsc_callback callback)
     dev->descriptor_callback = callback;
 }
 
+/**\brief Register callback for SET_INTERFACE control request
+ * \param dev dev usb device \ref _usbd_device
+ * \param callback pointer to user \ref usbd_ifc_callback
+ */
+inline static void usbd_reg_interface(usbd_device *dev, usbd_ifc_callback callback) {
+    dev->interface_callback = callback;
+}
+
+#if !defined(USBD_STREAM_DISABLED) || defined(__DOXYGEN__)
+/**\brief Register callback for control data streaming
+ * \details Streaming requires control buffer payload size not less than the EP0 size, requests
+ * are stalled otherwise.
+ * \param dev usb device \ref _usbd_device
+ * \param callback user control data streaming callback \ref usbd_ctl_stream_callback
+ */
+inline static void usbd_reg_stream(usbd_device *dev, usbd_ctl_stream_callback callback) {
+    dev->stream_callback = callback;
+}
+
+/**\brief Starts DATA-IN stage in streaming mode
+ * \details Call it from control callback before returning usbd_ack. DATA-IN payload will be
+ * requested chunk by chunk from \ref usbd_ctl_stream_callback.
+ * \param dev usb device \ref _usbd_device
+ * \param total total size of the DATA-IN payload
+ */
+inline static void usbd_ctl_stream(usbd_device *dev, uint16_t total) {
+    dev->status.data_ptr = 0;
+    dev->status.data_count = total;
+}
+#endif
+
+#if defined(USBD_DUAL_SPEED)
+/**\brief Converts full speed endpoint max packet size to the high speed one
+ * \param eptype endpoint type
+ * \param epsize full speed max packet size
+ * \return high speed max packet size
+ */
+inline static uint16_t usbd_hs_maxpacket(uint8_t eptype, uint16_t epsize) {
+    /* 0x02 is bulk endpoint type */
+    return ((eptype & 0x03) == 0x02) ? 0x200 : epsize;
+}
+#endif
+
 /**\brief Configure endpoint
+ * \note With \ref USBD_DUAL_SPEED bulk endpoint size is set to 512 bytes at high speed.
  * \param dev dev usb device \ref _usbd_device
  * \copydetails usbd_hw_ep_config
  */
 inline static bool usbd_ep_config(usbd_device *dev, uint8_t ep, uint8_t eptype, uint16_t epsize) {
+#if defined(USBD_DUAL_SPEED)
+    if ((dev->driver->getinfo() & USBD_HW_ENUMSPEED) == USBD_HW_SPEED_HS) {
+        epsize = usbd_hs_maxpacket(eptype, epsize);
+    }
+#endif
     return dev->driver->ep_config(ep, eptype, epsize);
 }
 
@@ -403,21 +892,29 @@ inline static void usbd_ep_deconfig(usbd_device *dev, uint8_t ep) {
 }
 
 /**\brief Register endpoint callback
+ * \details OUT and IN endpoints with the same index have separate callbacks. Register both for
+ * the bidirectional endpoint.
  * \param dev dev usb device \ref _usbd_device
- * \param ep endpoint index
+ * \param ep endpoint address. Endpoints 1 to \ref USBD_MAX_EP-1 are accepted.
  * \param callback pointer to user \ref usbd_evt_callback callback for endpoint events
  */
 inline static void usbd_reg_endpoint(usbd_device *dev, uint8_t ep, usbd_evt_callback callback) {
-    dev->endpoint[ep & 0x07] = callback;
+#if (USBD_MAX_EP > 1)
+    const uint8_t _i = (ep & 0x0F) - 1;
+    if (_i < (USBD_MAX_EP - 1)) dev->endpoint[ep >> 7][_i] = callback;
+#endif
 }
 
 /**\brief Registers event callback
  * \param dev dev usb device \ref _usbd_device
- * \param evt device \ref USB_EVENTS "event" wants to be registered
+ * \param evt device \ref USB_EVENTS "event" wants to be registered. Events from
+ * \ref USBD_MAX_EVENTS are ignored.
  * \param callback pointer to user \ref usbd_evt_callback for this event
  */
 inline static void usbd_reg_event(usbd_device *dev, uint8_t evt, usbd_evt_callback callback) {
-    dev->events[evt] = callback;
+#if (USBD_MAX_EVENTS > 0)
+    if (evt < USBD_MAX_EVENTS) dev->events[evt] = callback;
+#endif
 }
 
 /**\brief Write data to endpoint
@@ -425,7 +922,13 @@ inline static void usbd_reg_event(usbd_device *dev, uint8_t evt, usbd_evt_callba
  * \copydetails usbd_hw_ep_write
  */
 inline static int32_t usbd_ep_write(usbd_device *dev, uint8_t ep, const void *buf, uint16_t blen) {
+#if defined(USBD_TRACE)
+    const int32_t _r = dev->driver->ep_write(ep, buf, blen);
+    USBD_TRACE_ADD(USBD_TRACE_WR, ep, _r);
+    return _r;
+#else
     return dev->driver->ep_write(ep, buf, blen);
+#endif
 }
 
 /**\brief Read data from endpoint
@@ -433,7 +936,13 @@ inline static int32_t usbd_ep_write(usbd_device *dev, uint8_t ep, const void *bu
  * \copydetails usbd_hw_ep_read
  */
 inline static int32_t usbd_ep_read(usbd_device *dev, uint8_t ep, void *buf, uint16_t blen) {
+#if defined(USBD_TRACE)
+    const int32_t _r = dev->driver->ep_read(ep, buf, blen);
+    USBD_TRACE_ADD(USBD_TRACE_RD, ep, _r);
+    return _r;
+#else
     return dev->driver->ep_read(ep, buf, blen);
+#endif
 }
 
 /**\brief Stall endpoint
@@ -469,12 +978,66 @@ inline static uint8_t usbd_connect(usbd_device *dev, bool connect) {
     return dev->driver->connect(connect);
 }
 
+/**\brief Sets self-powered status reported by GET_STATUS request
+ * \param dev dev usb device \ref _usbd_device
+ * \param selfpowered TRUE if device is self-powered
+ */
+inline static void usbd_self_powered(usbd_device *dev, bool selfpowered) {
+    if (selfpowered) {
+        dev->status.device_status |= USBD_STATUS_SELFPWR;
+    } else {
+        dev->status.device_status &= ~USBD_STATUS_SELFPWR;
+    }
+}
+
+/**\brief Configures USB 2.0 link power management (LPM)
+ * \param dev dev usb device \ref _usbd_device
+ * \param enable Enables LPM if TRUE, disables otherwise
+ * \param besl Recommended baseline BESL value
+ * \param deep_besl Recommended deep BESL value. Used as a deep low-power mode threshold by OTG.
+ * \return TRUE if LPM is supported by hardware
+ * \note When LPM is enabled core serves USB 2.0 extension BOS descriptor if it is not provided by
+ * descriptor callback. bcdUSB of the device descriptor must be 0x0201 or above.
+ */
+inline static bool usbd_lpm_config(usbd_device *dev, bool enable, uint8_t besl, uint8_t deep_besl) {
+    if (dev->driver->lpm_config == 0) return false;
+    dev->status.lpm_besl = (besl & 0x0F) | (deep_besl << 4);
+    if (enable) {
+        dev->status.device_status |= USBD_STATUS_LPM;
+    } else {
+        dev->status.device_status &= ~USBD_STATUS_LPM;
+    }
+    dev->driver->lpm_config(enable, deep_besl & 0x0F);
+    return true;
+}
+
+/**\brief Applies OTG FIFO RAM partitioning plan
+ * \param dev dev usb device \ref _usbd_device
+ * \param plan pointer to the FIFO plan \ref usbd_fifo_plan. Computed layout will be reported back.
+ * NULL restores default greedy allocation.
+ * \return TRUE if plan is valid and applied. FALSE if it doesn't fit the FIFO RAM, hardware has no
+ * configurable FIFO or device is connected.
+ * \note Must be called before \ref usbd_enable or while device is disconnected. FIFOs of the
+ * enabled core are flushed.
+ */
+inline static bool usbd_fifo_plan(usbd_device *dev, struct usbd_fifo_plan *plan) {
+    if (dev->driver->fifo_plan == 0) return false;
+    return dev->driver->fifo_plan(plan);
+}
+
 /**\brief Retrieves status and capabilities.
  * \return current HW status, enumeration speed and capabilities \ref USBD_HW_CAPS */
 inline static uint32_t usbd_getinfo(usbd_device *dev) {
     return dev->driver->getinfo();
 }
 
+/**\brief Retrieves enumeration speed.
+ * \return \ref USBD_HW_SPEED_NC, \ref USBD_HW_SPEED_LS, \ref USBD_HW_SPEED_FS or \ref USBD_HW_SPEED_HS
+ * \note Valid after \ref usbd_evt_reset event.*/
+inline static uint32_t usbd_get_speed(usbd_device *dev) {
+    return dev->driver->getinfo() & USBD_HW_ENUMSPEED;
+}
+
 #endif //(__ASSEMBLER__)
 /** @} */
 /** @} */
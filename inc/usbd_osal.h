@@ -0,0 +1,145 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _USBD_OSAL_H_
+#define _USBD_OSAL_H_
+#if defined(__cplusplus)
+    extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usbd_core.h"
+
+/**\addtogroup USBD_OSAL OS abstraction layer
+ * \brief Blocking endpoint I/O for the RTOS threads.
+ * \details Requires \ref USBD_OSAL. Endpoint callbacks set per-endpoint event flags from the USB
+ * interrupt, threads sleep on these flags in \ref usbd_ep_write_wait and \ref usbd_ep_read_wait.
+ * @{ */
+
+#define USBD_OSAL_WAIT_FOREVER  0xFFFFFFFF  /**<\brief Infinite timeout.*/
+
+/**\brief Event flag for the endpoint. OUT endpoints use bits 0..15, IN endpoints bits 16..31.
+ * \note Flags object must hold the bits of all bound endpoints. IN endpoint 15 takes bit 31.*/
+#define USBD_OSAL_EPFLAG(ep)    (((ep) & 0x80) ? (0x10000UL << ((ep) & 0x0F)) : (0x01UL << ((ep) & 0x0F)))
+
+/**\brief Sets event flags
+ * \param obj event flags object
+ * \param flags flags to set
+ * \note Called from the USB interrupt.
+ */
+typedef void (*usbd_osal_flags_set)(void *obj, uint32_t flags);
+
+/**\brief Waits for any of the event flags
+ * \param obj event flags object
+ * \param flags flags to wait for
+ * \param timeout timeout in milliseconds. 0 for no wait, \ref USBD_OSAL_WAIT_FOREVER for
+ * infinite wait.
+ * \return flags from the mask that were set. These flags are cleared. 0 on timeout.
+ */
+typedef uint32_t (*usbd_osal_flags_wait)(void *obj, uint32_t flags, uint32_t timeout);
+
+/**\brief Takes a semaphore
+ * \param obj semaphore object
+ * \param timeout timeout in milliseconds
+ * \return TRUE if semaphore was taken
+ */
+typedef bool (*usbd_osal_sem_take)(void *obj, uint32_t timeout);
+
+/**\brief Gives a semaphore
+ * \param obj semaphore object
+ */
+typedef void (*usbd_osal_sem_give)(void *obj);
+
+/**\brief Represents an OS abstraction call table.
+ * \details Semaphore is optional. It serializes driver access from the different threads.*/
+struct usbd_osal {
+    usbd_osal_flags_set     flags_set;          /**<\copybrief usbd_osal_flags_set */
+    usbd_osal_flags_wait    flags_wait;         /**<\copybrief usbd_osal_flags_wait */
+    usbd_osal_sem_take      sem_take;           /**<\copybrief usbd_osal_sem_take */
+    usbd_osal_sem_give      sem_give;           /**<\copybrief usbd_osal_sem_give */
+};
+
+#if defined(USBD_OSAL) || defined(__DOXYGEN__)
+/**\brief Binds OS abstraction to the USB device
+ * \param dev usb device \ref _usbd_device
+ * \param osal pointer to the \ref usbd_osal call table
+ * \param flags event flags object
+ * \param sem semaphore object. NULL if not used.
+ */
+void usbd_osal_init(usbd_device *dev, const struct usbd_osal *osal, void *flags, void *sem);
+
+/**\brief Registers endpoint for the blocking I/O
+ * \details Replaces OUT and IN endpoint callbacks. Both directions of the endpoint index are
+ * served.
+ * Call it from \ref usbd_cfg_callback after endpoint configuration.
+ * \param dev usb device \ref _usbd_device
+ * \param ep endpoint number
+ */
+void usbd_osal_bind_ep(usbd_device *dev, uint8_t ep);
+
+/**\brief Writes packet to the IN endpoint waiting for the previous packet transmission
+ * \param dev usb device \ref _usbd_device
+ * \param ep endpoint number
+ * \param buf pointer to data buffer
+ * \param blen size of data
+ * \param timeout timeout in milliseconds. Applies to each of two waits, for the endpoint flag
+ * and for the driver semaphore, so the call may block up to 2*timeout.
+ * \return number of written bytes, -1 on timeout or error
+ */
+int32_t usbd_ep_write_wait(usbd_device *dev, uint8_t ep, const void *buf, uint16_t blen, uint32_t timeout);
+
+/**\brief Reads packet from the OUT endpoint waiting for its reception
+ * \param dev usb device \ref _usbd_device
+ * \param ep endpoint number
+ * \param buf pointer to data buffer
+ * \param blen size of data buffer
+ * \param timeout timeout in milliseconds. Applies to each of two waits, for the endpoint flag
+ * and for the driver semaphore, so the call may block up to 2*timeout. Received packet is left
+ * in the endpoint if the semaphore wait times out.
+ * \return number of read bytes, -1 on timeout or error
+ */
+int32_t usbd_ep_read_wait(usbd_device *dev, uint8_t ep, void *buf, uint16_t blen, uint32_t timeout);
+#endif
+
+#if defined(USBD_OSAL_PTHREAD) || defined(__DOXYGEN__)
+#include <pthread.h>
+#include <semaphore.h>
+
+/**\brief POSIX threads OS abstraction objects */
+struct usbd_osal_pthread {
+    pthread_mutex_t     mutex;      /**<\brief Event flags mutex.*/
+    pthread_cond_t      cond;       /**<\brief Event flags condition.*/
+    uint32_t            flags;      /**<\brief Event flags.*/
+    sem_t               sem;        /**<\brief Driver access semaphore.*/
+};
+
+/**\brief POSIX threads OS abstraction call table */
+extern const struct usbd_osal usbd_osal_pthread;
+
+/**\brief Initializes POSIX threads objects and binds them to the USB device
+ * \param dev usb device \ref _usbd_device
+ * \param os pointer to the objects storage
+ * \return TRUE on success
+ */
+bool usbd_osal_pthread_init(usbd_device *dev, struct usbd_osal_pthread *os);
+#endif
+
+/** @} */
+
+#if defined(__cplusplus)
+    }
+#endif
+#endif //_USBD_OSAL_H_
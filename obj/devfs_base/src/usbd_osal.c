@@ -0,0 +1,96 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usbd_osal.h"
+
+#if defined(USBD_OSAL)
+
+/** \brief Endpoint callback. Signals waiting threads.
+ * \param dev usb device
+ * \param event endpoint event
+ * \param ep active endpoint
+ */
+static void usbd_osal_evt(usbd_device *dev, uint8_t event, uint8_t ep) {
+    switch (event) {
+    case usbd_evt_isoinc:
+        /* missed OUT frame has no data to read */
+        if (!(ep & 0x80)) break;
+        /* fall through */
+    case usbd_evt_eptx:
+    case usbd_evt_eprx:
+        dev->osal->flags_set(dev->osal_flags, USBD_OSAL_EPFLAG(ep));
+        break;
+    default:
+        break;
+    }
+}
+
+static bool usbd_osal_lock(usbd_device *dev, uint32_t timeout) {
+    if ((dev->osal_sem == 0) || (dev->osal->sem_take == 0)) return true;
+    return dev->osal->sem_take(dev->osal_sem, timeout);
+}
+
+static void usbd_osal_unlock(usbd_device *dev) {
+    if ((dev->osal_sem == 0) || (dev->osal->sem_give == 0)) return;
+    dev->osal->sem_give(dev->osal_sem);
+}
+
+ __attribute__((externally_visible)) void usbd_osal_init(usbd_device *dev, const struct usbd_osal *osal, void *flags, void *sem) {
+    dev->osal = osal;
+    dev->osal_flags = flags;
+    dev->osal_sem = sem;
+}
+
+ __attribute__((externally_visible)) void usbd_osal_bind_ep(usbd_device *dev, uint8_t ep) {
+    usbd_reg_endpoint(dev, ep & 0x7F, usbd_osal_evt);
+    usbd_reg_endpoint(dev, ep | 0x80, usbd_osal_evt);
+    /* dropping stale OUT packet flag */
+    dev->osal->flags_wait(dev->osal_flags, USBD_OSAL_EPFLAG(ep & 0x7F), 0);
+    /* IN endpoint is idle after configuration */
+    dev->osal->flags_set(dev->osal_flags, USBD_OSAL_EPFLAG(ep | 0x80));
+}
+
+ __attribute__((externally_visible)) int32_t usbd_ep_write_wait(usbd_device *dev, uint8_t ep, const void *buf, uint16_t blen, uint32_t timeout) {
+    const uint32_t _f = USBD_OSAL_EPFLAG(ep | 0x80);
+    int32_t _r = -1;
+    /* waiting for the previous packet transmission */
+    if (!dev->osal->flags_wait(dev->osal_flags, _f, timeout)) return -1;
+    if (usbd_osal_lock(dev, timeout)) {
+        _r = usbd_ep_write(dev, ep | 0x80, buf, blen);
+        usbd_osal_unlock(dev);
+    }
+    /* endpoint is still idle if nothing was written */
+    if (_r < 0) dev->osal->flags_set(dev->osal_flags, _f);
+    return _r;
+}
+
+ __attribute__((externally_visible)) int32_t usbd_ep_read_wait(usbd_device *dev, uint8_t ep, void *buf, uint16_t blen, uint32_t timeout) {
+    const uint32_t _f = USBD_OSAL_EPFLAG(ep & 0x7F);
+    int32_t _r;
+    /* waiting for the packet reception */
+    if (!dev->osal->flags_wait(dev->osal_flags, _f, timeout)) return -1;
+    if (!usbd_osal_lock(dev, timeout)) {
+        /* packet is still in the endpoint buffer */
+        dev->osal->flags_set(dev->osal_flags, _f);
+        return -1;
+    }
+    _r = usbd_ep_read(dev, ep & 0x7F, buf, blen);
+    usbd_osal_unlock(dev);
+    return _r;
+}
+
+#endif //USBD_OSAL
@@ -19,18 +19,126 @@
 
 #define _MIN(a, b) ((a) < (b)) ? (a) : (b)
 
+#if defined(USBD_SPLIT_ISR)
+/* pending control request bit. follows the event bits */
+#define USBD_PEND_CTLREQ    usbd_evt_count
+/* no control request result latched for usbd_poll() */
+#define USBD_REPLY_NONE     0
+/* events which user callbacks are deferred to usbd_process_pending() */
+#define USBD_PEND_BUSEVT    ((1 << usbd_evt_reset) | (1 << usbd_evt_susp) | (1 << usbd_evt_wkup) | \
+                             (1 << usbd_evt_error) | (1 << usbd_evt_l1susp) | (1 << usbd_evt_l1wkup))
+#endif
+
+#if defined(USBD_STREAM_DISABLED)
+#define usbd_stream_ok(dev)     false
+#else
+/* streaming mode passes chunks through req->data, so it must fit EP0 packet */
+#define usbd_stream_ok(dev)     (((dev)->stream_callback != 0) && \
+                                 ((dev)->status.data_maxsize >= (dev)->status.ep0size))
+#endif
+
+#if defined(USBD_EVENT_QUEUE)
+/* endpoint events */
+#define USBD_EP_EVENTS      ((1 << usbd_evt_eptx) | (1 << usbd_evt_eprx) | (1 << usbd_evt_epsetup) | \
+                             (1 << usbd_evt_isoinc))
+/* overflowed endpoint event index in usbd_evt_queue::pend_ep_set and back */
+#define USBD_EP_PEND_IDX(evt)   (((evt) == usbd_evt_isoinc) ? 3 : (evt) - usbd_evt_eptx)
+#define USBD_EP_PEND_EVT(idx)   (((idx) == 3) ? usbd_evt_isoinc : (idx) + usbd_evt_eptx)
+/* overflowed endpoint event bit. IN endpoints in the high half */
+#define USBD_EP_PEND_BIT(ep)    (((ep) & 0x0F) | (((ep) & 0x80) >> 3))
+#endif
+
+#if defined(USBD_TRACE)
+usbd_trace_ring usbd_trace = {
+    .magic = USBD_TRACE_MAGIC,
+    .size = USBD_TRACE_SIZE,
+};
+#endif
+
 static void usbd_process_ep0 (usbd_device *dev, uint8_t event, uint8_t ep);
 
+/** \brief Returns data endpoint callback for the endpoint address
+ * \param dev pointer to usb device
+ * \param ep endpoint address, 1 to 15
+ * \return callback or NULL
+ */
+static usbd_evt_callback usbd_get_ep_callback(usbd_device *dev, uint8_t ep) {
+#if (USBD_MAX_EP > 1)
+    /* EP0 is handled by core and has no slot */
+    const uint8_t _i = (ep & 0x0F) - 1;
+    if (_i < (USBD_MAX_EP - 1)) return dev->endpoint[ep >> 7][_i];
+#endif
+    return 0;
+}
+
+/** \brief Returns event callback
+ * \param dev pointer to usb device
+ * \param evt usb event
+ * \return callback or NULL
+ */
+static usbd_evt_callback usbd_get_evt_callback(usbd_device *dev, uint8_t evt) {
+#if (USBD_MAX_EVENTS > 0)
+    if (evt < USBD_MAX_EVENTS) return dev->events[evt];
+#endif
+    return 0;
+}
+
+/** \brief Resets alternate settings for all interfaces
+ * \param dev pointer to usb device
+ * \return none
+ */
+static void usbd_reset_altsettings(usbd_device *dev) {
+    for (int i = 0; i < USBD_MAX_INTERFACES; i++) {
+        dev->status.alt_setting[i] = 0;
+    }
+}
+
+#if defined(USBD_SPLIT_ISR)
+/** \brief Latches pending event for the usbd_process_pending()
+ * \details usbd_process_evt() is the only writer of the \ref _usbd_device::pend_set and
+ * usbd_process_pending() is the only writer of the \ref _usbd_device::pend_ack, so no locking
+ * required. Event is pending while corresponding bits differ.
+ * \param dev pointer to usb device
+ * \param bit pending bit number
+ */
+static void usbd_latch(usbd_device *dev, uint8_t bit) {
+    const uint16_t _b = 1 << bit;
+    dev->pend_set = (dev->pend_set & ~_b) | ((dev->pend_ack & _b) ^ _b);
+    if (dev->kick_callback) dev->kick_callback(dev);
+}
+
+/** \brief Latches control request result for the usbd_poll()
+ * \details Result is published last, so usbd_poll() sees complete payload fields.
+ * \param dev pointer to usb device
+ * \param seq \ref _usbd_device::ctl_seq of the request
+ * \param r usbd_ack or usbd_fail
+ * \param data DATA-IN payload
+ * \param len DATA-IN payload length
+ */
+static void usbd_ctl_reply(usbd_device *dev, uint8_t seq, usbd_respond r, const void *data, uint16_t len) {
+    dev->rpl_data = data;
+    dev->rpl_len = len;
+    dev->rpl_seq = seq;
+    dev->rpl_result = r + 1;
+}
+#endif
+
 /** \brief Resets USB device state
  * \param dev pointer to usb device
  * \return none
  */
 static void usbd_process_reset(usbd_device *dev) {
+#if defined(USBD_SPLIT_ISR)
+    /* drops the request that may be in processing by usbd_process_pending() */
+    dev->ctl_seq++;
+    dev->ctl_parked = false;
+#endif
     dev->status.device_state = usbd_state_default;
     dev->status.control_state = usbd_ctl_idle;
     dev->status.device_cfg = 0;
+    dev->status.device_status &= (USBD_STATUS_SELFPWR | USBD_STATUS_LPM);
+    usbd_reset_altsettings(dev);
     dev->driver->ep_config(0, USB_EPTYPE_CONTROL, dev->status.ep0size);
-    dev->endpoint[0] = usbd_process_ep0;
     dev->driver->setaddr(0);
 }
 
@@ -64,6 +172,7 @@ static usbd_respond usbd_configure(usbd_device *dev, uint8_t config) {
     if (dev->config_callback) {
         if (dev->config_callback(dev, config) == usbd_ack) {
             dev->status.device_cfg = config;
+            usbd_reset_altsettings(dev);
             dev->status.device_state = (config) ? usbd_state_configured : usbd_state_addressed;
             return usbd_ack;
         }
@@ -72,6 +181,146 @@ static usbd_respond usbd_configure(usbd_device *dev, uint8_t config) {
 }
 
 
+/** \brief SET_INTERFACE request processing
+ * \param dev usbd_device
+ * \param iface interface number from request
+ * \param altsetting alternate setting number from request
+ * \return usbd_ack if success
+ */
+static usbd_respond usbd_set_interface(usbd_device *dev, uint16_t iface, uint16_t altsetting) {
+    if (dev->status.device_state != usbd_state_configured) return usbd_fail;
+    if (iface >= USBD_MAX_INTERFACES || altsetting > 0xFF) return usbd_fail;
+    if (dev->interface_callback) {
+        if (dev->interface_callback(dev, iface, altsetting) != usbd_ack) return usbd_fail;
+    } else if (altsetting != 0) {
+        return usbd_fail;
+    }
+    dev->status.alt_setting[iface] = altsetting;
+    return usbd_ack;
+}
+
+/** \brief Builds BOS descriptor with USB 2.0 extension capability
+ * \param dev pointer to usb device
+ * \param buffer pointer to descriptor buffer
+ * \return size of the BOS descriptor
+ */
+static uint16_t usbd_get_lpm_bos(usbd_device *dev, void *buffer) {
+    struct usb_bos_descriptor *bos = buffer;
+    struct usb_usb20ext_descriptor *ext = (void*)((uint8_t*)buffer + sizeof(struct usb_bos_descriptor));
+    const uint16_t _len = sizeof(struct usb_bos_descriptor) + sizeof(struct usb_usb20ext_descriptor);
+    bos->bLength = sizeof(struct usb_bos_descriptor);
+    bos->bDescriptorType = USB_DTYPE_BOS;
+    bos->wTotalLength = _len;
+    bos->bNumDeviceCaps = 1;
+    ext->bLength = sizeof(struct usb_usb20ext_descriptor);
+    ext->bDescriptorType = USB_DTYPE_DEVCAP;
+    ext->bDevCapabilityType = USB_DEVCAP_USB20EXT;
+    ext->bmAttributes = USB_USB20EXT_LPM | USB_USB20EXT_BESL |
+                        USB_USB20EXT_BBESL_VALID | USB_USB20EXT_DBESL_VALID |
+                        USB_USB20EXT_BBESL(dev->status.lpm_besl) |
+                        USB_USB20EXT_DBESL(dev->status.lpm_besl >> 4);
+    return _len;
+}
+
+#if defined(USBD_DUAL_SPEED)
+/** \brief Converts endpoint descriptors from full speed to high speed
+ * \details Bulk endpoints get 512 bytes packet size, interrupt and isochronous
+ * endpoints get polling interval in microframes.
+ * \param buffer pointer to the configuration descriptor
+ * \param len configuration descriptor length
+ */
+static void usbd_hs_endpoints(uint8_t *buffer, uint16_t len) {
+    while ((len >= 2) && (buffer[0] >= 2) && (buffer[0] <= len)) {
+        if ((buffer[1] == USB_DTYPE_ENDPOINT) && (buffer[0] >= sizeof(struct usb_endpoint_descriptor))) {
+            struct usb_endpoint_descriptor *epd = (void*)buffer;
+            uint8_t _t = epd->bInterval;
+            switch (epd->bmAttributes & 0x03) {
+            case USB_EPTYPE_BULK:
+                _t = 0;
+                break;
+            case USB_EPTYPE_INTERRUPT:
+                /* N frames to 2^(M-1) microframes */
+                for (_t = 4; (_t < 16) && ((1U << (_t - 3)) <= epd->bInterval); _t++);
+                break;
+            case USB_EPTYPE_ISOCHRONUS:
+                /* 2^(N-1) frames to 2^(M-1) microframes */
+                _t = (_t > 13) ? 16 : _t + 3;
+                break;
+            default:
+                break;
+            }
+            epd->bInterval = _t;
+            epd->wMaxPacketSize = usbd_hs_maxpacket(epd->bmAttributes, epd->wMaxPacketSize);
+        }
+        len -= buffer[0];
+        buffer += buffer[0];
+    }
+}
+
+/** \brief Builds configuration descriptor for the given speed
+ * \details Copies full speed configuration descriptor passed by the user to the
+ * control buffer and converts it to the high speed if required.
+ * \param dev pointer to usb device
+ * \param req pointer to control request
+ * \param dtype \ref USB_DTYPE_CONFIGURATION or \ref USB_DTYPE_OTHER
+ * \param hs convert configuration to high speed
+ * \return usbd_ack if descriptor fits control buffer
+ */
+static usbd_respond usbd_speed_config(usbd_device *dev, usbd_ctlreq *req, uint8_t dtype, bool hs) {
+    const uint8_t *src = dev->status.data_ptr;
+    uint16_t len = dev->status.data_count;
+    if ((len < 2) || (len > dev->status.data_maxsize)) return usbd_fail;
+    if (src != req->data) {
+        for (int i = 0; i < len; i++) {
+            req->data[i] = src[i];
+        }
+    }
+    req->data[1] = dtype;
+    if (hs) usbd_hs_endpoints(req->data, len);
+    dev->status.data_ptr = req->data;
+    return usbd_ack;
+}
+
+/** \brief Requests descriptor of the given type from the user
+ * \param dev pointer to usb device
+ * \param req pointer to control request
+ * \param wvalue descriptor type and index
+ * \return usbd_ack if descriptor passed
+ */
+static usbd_respond usbd_get_user_desc(usbd_device *dev, usbd_ctlreq *req, uint16_t wvalue) {
+    uint16_t _t = req->wValue;
+    dev->status.data_ptr = req->data;
+    dev->status.data_count = dev->status.data_maxsize;
+    req->wValue = wvalue;
+    usbd_respond r = dev->descriptor_callback(req, &(dev->status.data_ptr), &(dev->status.data_count));
+    req->wValue = _t;
+    return r;
+}
+
+/** \brief Builds device qualifier descriptor from the device descriptor
+ * \param dev pointer to usb device
+ * \param req pointer to control request
+ * \return usbd_ack if descriptor is built
+ */
+static usbd_respond usbd_get_qualifier(usbd_device *dev, usbd_ctlreq *req) {
+    if (dev->status.data_maxsize < sizeof(struct usb_qualifier_descriptor)) return usbd_fail;
+    if (usbd_get_user_desc(dev, req, USB_DTYPE_DEVICE << 8) != usbd_ack) return usbd_fail;
+    const uint8_t *src = dev->status.data_ptr;
+    if (dev->status.data_count < sizeof(struct usb_device_descriptor)) return usbd_fail;
+    /* bcdUSB, class, subclass, protocol and bMaxPacketSize0 are at the same offsets */
+    for (int i = 2; i < 8; i++) {
+        req->data[i] = src[i];
+    }
+    req->data[8] = src[offsetof(struct usb_device_descriptor, bNumConfigurations)];
+    req->data[9] = 0;
+    req->data[0] = sizeof(struct usb_qualifier_descriptor);
+    req->data[1] = USB_DTYPE_QUALIFIER;
+    dev->status.data_ptr = req->data;
+    dev->status.data_count = sizeof(struct usb_qualifier_descriptor);
+    return usbd_ack;
+}
+#endif
+
 /** \brief Standard control request processing for device
  * \param dev pointer to usb device
  * \param req pointer to control request
@@ -80,23 +329,54 @@ static usbd_respond usbd_configure(usbd_device *dev, uint8_t config) {
 static usbd_respond usbd_process_devrq (usbd_device *dev, usbd_ctlreq *req) {
     switch (req->bRequest) {
     case USB_STD_CLEAR_FEATURE:
-        /* not yet supported */
+        if (req->wValue == USB_FEAT_REMOTE_WKUP) {
+            dev->status.device_status &= ~USBD_STATUS_RWAKEUP;
+            return usbd_ack;
+        }
         break;
     case USB_STD_GET_CONFIG:
         req->data[0] = dev->status.device_cfg;
         return usbd_ack;
     case USB_STD_GET_DESCRIPTOR:
         if (req->wValue == ((USB_DTYPE_STRING << 8) | INTSERIALNO_DESCRIPTOR )) {
+            if (dev->status.data_maxsize < USBD_SERIALNO_SIZE) break;
             dev->status.data_count = dev->driver->get_serialno_desc(req->data);
             return usbd_ack;
         } else {
             if (dev->descriptor_callback) {
-                return dev->descriptor_callback(req, &(dev->status.data_ptr), &(dev->status.data_count));
+                usbd_respond r = dev->descriptor_callback(req, &(dev->status.data_ptr), &(dev->status.data_count));
+#if defined(USBD_DUAL_SPEED)
+                if ((r == usbd_ack) && ((req->wValue >> 8) == USB_DTYPE_CONFIGURATION) &&
+                    (usbd_get_speed(dev) == USBD_HW_SPEED_HS)) {
+                    return usbd_speed_config(dev, req, USB_DTYPE_CONFIGURATION, true);
+                }
+#endif
+                if (r != usbd_fail) return r;
+#if defined(USBD_DUAL_SPEED)
+                /* qualifier and other speed configuration for the high speed capable device */
+                if (usbd_getinfo(dev) & USBD_HW_HS) {
+                    if (req->wValue == (USB_DTYPE_QUALIFIER << 8)) {
+                        return usbd_get_qualifier(dev, req);
+                    }
+                    if ((req->wValue >> 8) == USB_DTYPE_OTHER) {
+                        if (usbd_get_user_desc(dev, req, (USB_DTYPE_CONFIGURATION << 8) | (req->wValue & 0xFF)) != usbd_ack) {
+                            return usbd_fail;
+                        }
+                        return usbd_speed_config(dev, req, USB_DTYPE_OTHER,
+                                                 usbd_get_speed(dev) != USBD_HW_SPEED_HS);
+                    }
+                }
+#endif
+            }
+            if ((req->wValue == (USB_DTYPE_BOS << 8)) && (dev->status.device_status & USBD_STATUS_LPM) &&
+                (dev->status.data_maxsize >= sizeof(struct usb_bos_descriptor) + sizeof(struct usb_usb20ext_descriptor))) {
+                dev->status.data_count = usbd_get_lpm_bos(dev, req->data);
+                return usbd_ack;
             }
         }
         break;
     case USB_STD_GET_STATUS:
-        req->data[0] = 0;
+        req->data[0] = dev->status.device_status & (USBD_STATUS_SELFPWR | USBD_STATUS_RWAKEUP);
         req->data[1] = 0;
         return usbd_ack;
     case USB_STD_SET_ADDRESS:
@@ -112,7 +392,10 @@ static usbd_respond usbd_process_devrq (usbd_device *dev, usbd_ctlreq *req) {
         /* should be externally handled */
         break;
     case USB_STD_SET_FEATURE:
-        /* not yet supported */
+        if (req->wValue == USB_FEAT_REMOTE_WKUP) {
+            dev->status.device_status |= USBD_STATUS_RWAKEUP;
+            return usbd_ack;
+        }
         break;
     default:
         break;
@@ -126,12 +409,18 @@ static usbd_respond usbd_process_devrq (usbd_device *dev, usbd_ctlreq *req) {
  * \return TRUE if request is handled
  */
 static usbd_respond usbd_process_intrq(usbd_device *dev, usbd_ctlreq *req) {
-    (void)dev;
     switch (req->bRequest) {
     case USB_STD_GET_STATUS:
         req->data[0] = 0;
         req->data[1] = 0;
         return usbd_ack;
+    case USB_STD_GET_INTERFACE:
+        if (dev->status.device_state != usbd_state_configured) break;
+        if (req->wIndex >= USBD_MAX_INTERFACES) break;
+        req->data[0] = dev->status.alt_setting[req->wIndex];
+        return usbd_ack;
+    case USB_STD_SET_INTERFACE:
+        return usbd_set_interface(dev, req->wIndex, req->wValue);
     default:
         break;
     }
@@ -204,20 +493,37 @@ static void usbd_stall_pid(usbd_device *dev, uint8_t ep) {
  */
 static void usbd_process_eptx(usbd_device *dev, uint8_t ep) {
     int32_t _t;
+    const void *_buf;
     switch (dev->status.control_state) {
     case usbd_ctl_ztxdata:
     case usbd_ctl_txdata:
         _t = _MIN(dev->status.data_count, dev->status.ep0size);
-        dev->driver->ep_write(ep, dev->status.data_ptr, _t);
-        dev->status.data_ptr = (uint8_t*)dev->status.data_ptr + _t;
+        _buf = dev->status.data_ptr;
+#if !defined(USBD_STREAM_DISABLED)
+        if (_buf == 0) {
+            /* streaming mode. requesting next chunk from the callback */
+            usbd_ctlreq *const req = dev->status.data_buf;
+            if (_t && (dev->stream_callback(dev, req, dev->status.data_offset, _t) != usbd_ack)) {
+                usbd_stall_pid(dev, ep);
+                break;
+            }
+            _buf = req->data;
+            dev->status.data_offset += _t;
+        } else
+#endif
+        {
+            dev->status.data_ptr = (uint8_t*)dev->status.data_ptr + _t;
+        }
         dev->status.data_count -= _t;
-        /* if all data is not sent */
-        if (0 != dev->status.data_count) break;
         /* if last packet has a EP0 size and host awaiting for the more data ZLP should be sent*/
         /* if ZLP required, control state will be unchanged, therefore next TX event sends ZLP */
-        if ( usbd_ctl_txdata == dev->status.control_state || _t != dev->status.ep0size ) {
+        if ((0 == dev->status.data_count) &&
+            (usbd_ctl_txdata == dev->status.control_state || _t != dev->status.ep0size)) {
             dev->status.control_state = usbd_ctl_lastdata; /* no ZLP required */
         }
+        /* state is updated before the write. TX completion may preempt us if the request
+         * was completed outside of the USB interrupt */
+        usbd_ep_write(dev, ep, _buf, _t);
         break;
     case usbd_ctl_lastdata:
         dev->status.control_state = usbd_ctl_statusout;
@@ -233,6 +539,38 @@ static void usbd_process_eptx(usbd_device *dev, uint8_t ep) {
     }
 }
 
+/** \brief Starts DATA-IN or STATUS-IN stage for the accepted control request
+ * \param dev pointer to usb device
+ * \param req pointer to usb control request
+ * \param ep endpoint number
+ */
+static void usbd_process_ack(usbd_device *dev, usbd_ctlreq *req, uint8_t ep) {
+    if (req->bmRequestType & USB_REQ_DEVTOHOST) {
+        /* NULL data pointer means streaming mode. chunks are passed through req->data */
+        if ((dev->status.data_ptr == 0) && !usbd_stream_ok(dev)) {
+            usbd_stall_pid(dev, ep);
+            return;
+        }
+#if !defined(USBD_STREAM_DISABLED)
+        dev->status.data_offset = 0;
+#endif
+        /* return data from function */
+        if (dev->status.data_count >= req->wLength) {
+            dev->status.data_count = req->wLength;
+            dev->status.control_state = usbd_ctl_txdata;
+        } else {
+            /* DATA IN packet smaller than requested */
+            /* ZLP maybe wanted */
+            dev->status.control_state = usbd_ctl_ztxdata;
+        }
+        usbd_process_eptx(dev, ep | 0x80);
+    } else {
+        /* confirming by ZLP in STATUS_IN stage */
+        dev->status.control_state = usbd_ctl_statusin;
+        usbd_ep_write(dev, ep | 0x80, 0, 0);
+    }
+}
+
 /** \brief Control endpoint RX event processing
  * \param dev pointer to usb device
  * \param ep endpoint number
@@ -242,8 +580,23 @@ static void usbd_process_eprx(usbd_device *dev, uint8_t ep) {
     usbd_ctlreq *const req = dev->status.data_buf;
     switch (dev->status.control_state) {
     case usbd_ctl_idle:
+#if defined(USBD_SPLIT_ISR)
+        if (dev->ctl_busy) {
+            /* control buffer is owned by the request handler. SETUP is parked in the private
+             * buffer until it's released. There is no room for the DATA OUT stage */
+            usbd_ctlreq *const _s = (usbd_ctlreq*)dev->ctl_setup;
+            if ((0x08 != usbd_ep_read(dev, ep, _s, sizeof(dev->ctl_setup))) ||
+                (!(_s->bmRequestType & USB_REQ_DEVTOHOST) && _s->wLength)) {
+                usbd_stall_pid(dev, ep);
+                return;
+            }
+            dev->status.control_state = usbd_ctl_deferred;
+            dev->ctl_parked = true;
+            return;
+        }
+#endif
         /* read SETUP packet, send STALL_PID if incorrect packet length */
-        if (0x08 !=  dev->driver->ep_read(ep, req, dev->status.data_maxsize)) {
+        if (0x08 !=  usbd_ep_read(dev, ep, req, dev->status.data_maxsize)) {
             usbd_stall_pid(dev, ep);
             return;
         }
@@ -251,8 +604,8 @@ static void usbd_process_eprx(usbd_device *dev, uint8_t ep) {
         dev->status.data_count = req->wLength;
         /* processing request with no payload data*/
         if ((req->bmRequestType & USB_REQ_DEVTOHOST) || (0 == req->wLength)) break;
-        /* checking available memory for DATA OUT stage */
-        if (req->wLength > dev->status.data_maxsize) {
+        /* checking available memory for DATA OUT stage. Streaming mode is used if it doesn't fit */
+        if ((req->wLength > dev->status.data_maxsize) && !usbd_stream_ok(dev)) {
             usbd_stall_pid(dev, ep);
             return;
         }
@@ -260,8 +613,22 @@ static void usbd_process_eprx(usbd_device *dev, uint8_t ep) {
         dev->status.control_state = usbd_ctl_rxdata;
         return;
     case usbd_ctl_rxdata:
+#if !defined(USBD_STREAM_DISABLED)
+        if (req->wLength > dev->status.data_maxsize) {
+            /* streaming mode. passing DATA OUT packet to the callback through req->data */
+            _t = usbd_ep_read(dev, ep, req->data, dev->status.data_maxsize);
+            if ((dev->status.data_count < _t) ||
+                (dev->stream_callback(dev, req, req->wLength - dev->status.data_count, _t) != usbd_ack)) {
+                usbd_stall_pid(dev, ep);
+                return;
+            }
+            dev->status.data_count -= _t;
+            if (0 != dev->status.data_count) return;
+            break;
+        }
+#endif
         /*receive DATA OUT packet(s) */
-        _t = dev->driver->ep_read(ep, dev->status.data_ptr, dev->status.data_count);
+        _t = usbd_ep_read(dev, ep, dev->status.data_ptr, dev->status.data_count);
         if (dev->status.data_count < _t) {
         /* if received packet is large than expected */
         /* Must be error. Let's drop this request */
@@ -276,7 +643,7 @@ static void usbd_process_eprx(usbd_device *dev, uint8_t ep) {
         break;
     case usbd_ctl_statusout:
         /* fake reading STATUS OUT */
-        dev->driver->ep_read(ep, 0, 0);
+        usbd_ep_read(dev, ep, 0, 0);
         dev->status.control_state = usbd_ctl_idle;
         usbd_process_callback(dev);
         return;
@@ -285,30 +652,24 @@ static void usbd_process_eprx(usbd_device *dev, uint8_t ep) {
         usbd_stall_pid(dev, ep);
         return;
     }
+#if defined(USBD_SPLIT_ISR)
+    /* usb request received. EP0 NAKs until it's handled by usbd_process_pending(). Control
+     * buffer is owned by the handler until it's done */
+    dev->status.control_state = usbd_ctl_deferred;
+    dev->ctl_busy = true;
+    usbd_latch(dev, USBD_PEND_CTLREQ);
+    return;
+#endif
     /* usb request received. let's handle it */
     dev->status.data_ptr = req->data;
     dev->status.data_count = /*req->wLength;*/dev->status.data_maxsize;
     switch (usbd_process_request(dev, req)) {
     case usbd_ack:
-        if (req->bmRequestType & USB_REQ_DEVTOHOST) {
-            /* return data from function */
-            if (dev->status.data_count >= req->wLength) {
-                dev->status.data_count = req->wLength;
-                dev->status.control_state = usbd_ctl_txdata;
-            } else {
-                /* DATA IN packet smaller than requested */
-                /* ZLP maybe wanted */
-                dev->status.control_state = usbd_ctl_ztxdata;
-            }
-            usbd_process_eptx(dev, ep | 0x80);
-        } else {
-            /* confirming by ZLP in STATUS_IN stage */
-            dev->driver->ep_write(ep | 0x80, 0, 0);
-            dev->status.control_state = usbd_ctl_statusin;
-        }
+        usbd_process_ack(dev, req, ep);
         break;
     case usbd_nak:
-        dev->status.control_state = usbd_ctl_statusin;
+        /* request deferred. EP0 NAKs until usbd_ctl_complete() or usbd_ctl_stall() */
+        dev->status.control_state = usbd_ctl_deferred;
         break;
     default:
         usbd_stall_pid(dev, ep);
@@ -326,6 +687,10 @@ static void usbd_process_ep0 (usbd_device *dev, uint8_t event, uint8_t ep) {
         /* force switch to setup state */
         dev->status.control_state = usbd_ctl_idle;
         dev->complete_callback = 0;
+#if defined(USBD_SPLIT_ISR)
+        dev->ctl_seq++;
+        dev->ctl_parked = false;
+#endif
         /* fall through */
     case usbd_evt_eprx:
         usbd_process_eprx(dev, ep);
@@ -336,8 +701,74 @@ static void usbd_process_ep0 (usbd_device *dev, uint8_t event, uint8_t ep) {
     default:
         break;
     }
+    USBD_TRACE_ADD(USBD_TRACE_CTL, ep, dev->status.control_state);
+}
+
+
+#if defined(USBD_EVENT_QUEUE)
+/** \brief Calls user callbacks for the event
+ * \param dev usb device
+ * \param evt usb event
+ * \param ep active endpoint
+ */
+static void usbd_dispatch_evt(usbd_device *dev, uint8_t evt, uint8_t ep) {
+    usbd_evt_callback _cb;
+    if ((USBD_EP_EVENTS & (1 << evt)) && (ep & 0x0F)) {
+        _cb = usbd_get_ep_callback(dev, ep);
+        if (_cb) _cb(dev, evt, ep);
+    }
+    _cb = usbd_get_evt_callback(dev, evt);
+    if (_cb) _cb(dev, evt, ep);
 }
 
+/** \brief Gets size of the received packet for the queued event
+ * \param dev usb device
+ * \param evt usb event
+ * \param ep active endpoint
+ * \return packet size or 0
+ */
+static uint16_t usbd_peek_len(usbd_device *dev, uint8_t evt, uint8_t ep) {
+    int32_t _l;
+    if ((evt != usbd_evt_eprx) && (evt != usbd_evt_epsetup)) return 0;
+    if (dev->driver->ep_peek == 0) return 0;
+    _l = dev->driver->ep_peek(ep);
+    return (_l < 0) ? 0 : _l;
+}
+
+/** \brief Queues event for the usbd_process_queue()
+ * \param dev usb device
+ * \param evt usb event
+ * \param ep active endpoint
+ */
+static void usbd_queue_evt(usbd_device *dev, uint8_t evt, uint8_t ep) {
+    usbd_evt_queue *const q = &dev->queue;
+    const uint8_t _h = q->head;
+    /* nothing to call */
+    if (!usbd_get_evt_callback(dev, evt) &&
+        !((USBD_EP_EVENTS & (1 << evt)) && (ep & 0x0F) && usbd_get_ep_callback(dev, ep))) return;
+    if ((uint8_t)(_h - q->tail) >= USBD_EVENT_QUEUE_SIZE) {
+        /* queue is full. latching the event for the usbd_process_queue(). unread packet stays
+         * NAKed, so repeated event for the same endpoint has nothing to add */
+        q->overflow++;
+        if (USBD_EP_EVENTS & (1 << evt)) {
+            const uint8_t _i = USBD_EP_PEND_IDX(evt);
+            const uint32_t _b = 1UL << USBD_EP_PEND_BIT(ep);
+            q->pend_ep_set[_i] = (q->pend_ep_set[_i] & ~_b) | ((q->pend_ep_ack[_i] & _b) ^ _b);
+        } else {
+            const uint16_t _b = 1 << evt;
+            q->pend_set = (q->pend_set & ~_b) | ((q->pend_ack & _b) ^ _b);
+        }
+    } else {
+        q->evt[_h & (USBD_EVENT_QUEUE_SIZE - 1)].evt = evt;
+        q->evt[_h & (USBD_EVENT_QUEUE_SIZE - 1)].ep = ep;
+        q->evt[_h & (USBD_EVENT_QUEUE_SIZE - 1)].len = usbd_peek_len(dev, evt, ep);
+        q->head = _h + 1;
+    }
+#if defined(USBD_EVENT_QUEUE_WFE)
+    __asm__ volatile ("sev");
+#endif
+}
+#endif
 
 /** \brief General event processing callback
  * \param dev usb device
@@ -345,21 +776,228 @@ static void usbd_process_ep0 (usbd_device *dev, uint8_t event, uint8_t ep) {
  * \param ep active endpoint
  */
 static void usbd_process_evt(usbd_device *dev, uint8_t evt, uint8_t ep) {
+#if !defined(USBD_EVENT_QUEUE)
+    usbd_evt_callback _cb;
+#endif
+    USBD_TRACE_ADD(USBD_TRACE_EVT, ep, evt | (dev->status.control_state << 8));
     switch (evt) {
     case usbd_evt_reset:
         usbd_process_reset(dev);
         break;
+    case usbd_evt_susp:
+        dev->status.device_status |= USBD_STATUS_SUSPEND;
+        break;
+    case usbd_evt_wkup:
+        dev->status.device_status &= ~USBD_STATUS_SUSPEND;
+        break;
+    case usbd_evt_l1susp:
+        dev->status.device_status |= USBD_STATUS_L1SLEEP;
+        break;
+    case usbd_evt_l1wkup:
+        dev->status.device_status &= ~USBD_STATUS_L1SLEEP;
+        break;
     case usbd_evt_eprx:
     case usbd_evt_eptx:
     case usbd_evt_epsetup:
-        if (dev->endpoint[ep & 0x07]) dev->endpoint[ep & 0x07](dev, evt, ep);
+    case usbd_evt_isoinc:
+        if (0 == (ep & 0x0F)) {
+            usbd_process_ep0(dev, evt, ep);
+            break;
+        }
+#if !defined(USBD_EVENT_QUEUE)
+        /* with event queue data endpoint callbacks are called from usbd_process_queue() */
+        _cb = usbd_get_ep_callback(dev, ep);
+        if (_cb) _cb(dev, evt, ep);
+#endif
         break;
     default:
         break;
     }
-    if (dev->events[evt]) dev->events[evt](dev, evt, ep);
+#if defined(USBD_SPLIT_ISR)
+    /* bus events are reported from usbd_process_pending() */
+    if (USBD_PEND_BUSEVT & (1 << evt)) {
+        usbd_latch(dev, evt);
+        return;
+    }
+#endif
+#if defined(USBD_EVENT_QUEUE)
+    usbd_queue_evt(dev, evt, ep);
+#else
+    _cb = usbd_get_evt_callback(dev, evt);
+    if (_cb) _cb(dev, evt, ep);
+#endif
 }
 
+#if defined(USBD_SPLIT_ISR)
+/** \brief Applies control request result latched by usbd_process_pending() or usbd_ctl_complete()
+ * \details DATA or STATUS stage is started here, so EP0 is driven by the USB interrupt only.
+ * SETUP parked while the control buffer was owned by the handler is moved to the buffer and
+ * latched for the usbd_process_pending().
+ * \param dev usb device
+ */
+static void usbd_process_reply(usbd_device *dev) {
+    usbd_ctlreq *const req = dev->status.data_buf;
+    const uint8_t _r = dev->rpl_result;
+    if (dev->ctl_busy) return;
+    if (_r != USBD_REPLY_NONE) {
+        dev->rpl_result = USBD_REPLY_NONE;
+        /* dropping result of the request aborted by the new SETUP or bus reset */
+        if ((dev->rpl_seq == dev->ctl_seq) && !dev->ctl_parked &&
+            (dev->status.control_state == usbd_ctl_deferred)) {
+            if (_r == usbd_ack + 1) {
+                if (req->bmRequestType & USB_REQ_DEVTOHOST) {
+                    dev->status.data_ptr = (void*)dev->rpl_data;
+                    dev->status.data_count = dev->rpl_len;
+                }
+                usbd_process_ack(dev, req, 0);
+            } else {
+                usbd_stall_pid(dev, 0);
+            }
+            USBD_TRACE_ADD(USBD_TRACE_CTL, 0, dev->status.control_state);
+        }
+    }
+    if (dev->ctl_parked) {
+        dev->ctl_parked = false;
+        if (dev->status.control_state != usbd_ctl_deferred) return;
+        *req = *(const usbd_ctlreq*)dev->ctl_setup;
+        dev->ctl_busy = true;
+        usbd_latch(dev, USBD_PEND_CTLREQ);
+    }
+}
+#endif
+
  __attribute__((externally_visible)) void usbd_poll(usbd_device *dev) {
+#if defined(USBD_SPLIT_ISR)
+    usbd_process_reply(dev);
+#endif
     dev->driver->poll(dev, usbd_process_evt);
 }
+
+ __attribute__((externally_visible)) bool usbd_remote_wakeup(usbd_device *dev) {
+    const uint8_t _rwu = USBD_STATUS_RWAKEUP | USBD_STATUS_SUSPEND;
+    /* remote wakeup from L1 is allowed by the host in LPM token and checked by driver */
+    if (((dev->status.device_status & _rwu) != _rwu) &&
+        !(dev->status.device_status & USBD_STATUS_L1SLEEP)) return false;
+    if (dev->driver->remote_wakeup == 0 || !dev->driver->remote_wakeup()) return false;
+    dev->status.device_status &= ~(USBD_STATUS_SUSPEND | USBD_STATUS_L1SLEEP);
+    return true;
+}
+
+ __attribute__((externally_visible)) bool usbd_ctl_complete(usbd_device *dev, const void *data, uint16_t len) {
+    usbd_ctlreq *const req = dev->status.data_buf;
+    if (dev->status.control_state != usbd_ctl_deferred) return false;
+#if defined(USBD_SPLIT_ISR)
+    /* DATA or STATUS stage is started by usbd_poll() */
+    usbd_ctl_reply(dev, dev->ctl_seq, usbd_ack, (data) ? data : req->data, len);
+    if (dev->irq_callback) dev->irq_callback(dev);
+#else
+    if (req->bmRequestType & USB_REQ_DEVTOHOST) {
+        dev->status.data_ptr = (data) ? (void*)data : req->data;
+        dev->status.data_count = len;
+    }
+    usbd_process_ack(dev, req, 0);
+#endif
+    return true;
+}
+
+ __attribute__((externally_visible)) bool usbd_ctl_stall(usbd_device *dev) {
+    if (dev->status.control_state != usbd_ctl_deferred) return false;
+#if defined(USBD_SPLIT_ISR)
+    usbd_ctl_reply(dev, dev->ctl_seq, usbd_fail, 0, 0);
+    if (dev->irq_callback) dev->irq_callback(dev);
+#else
+    usbd_stall_pid(dev, 0);
+#endif
+    return true;
+}
+
+#if defined(USBD_SPLIT_ISR)
+/** \brief Handles control request latched by the USB interrupt
+ * \details Only the result is latched back. DATA or STATUS stage is started by usbd_poll(), so
+ * EP0 is never touched from here. USB interrupt doesn't write the control buffer while it's
+ * owned by the handler, a new SETUP is parked in the private buffer.
+ * \param dev usb device
+ */
+static void usbd_process_ctlreq(usbd_device *dev) {
+    usbd_ctlreq *const req = dev->status.data_buf;
+    const uint8_t _seq = dev->ctl_seq;
+    if (!dev->ctl_busy) return;
+    /* skipping request aborted by the new SETUP or bus reset */
+    if ((dev->status.control_state == usbd_ctl_deferred) && !dev->ctl_parked) {
+        dev->status.data_ptr = req->data;
+        dev->status.data_count = dev->status.data_maxsize;
+        dev->complete_callback = 0;
+        const usbd_respond _r = usbd_process_request(dev, req);
+        /* usbd_nak keeps request deferred until usbd_ctl_complete() or usbd_ctl_stall() */
+        if (_r != usbd_nak) {
+            usbd_ctl_reply(dev, _seq, _r, dev->status.data_ptr, dev->status.data_count);
+        }
+    }
+    /* releasing control buffer */
+    dev->ctl_busy = false;
+    if (dev->irq_callback) dev->irq_callback(dev);
+}
+
+ __attribute__((externally_visible)) void usbd_process_pending(usbd_device *dev) {
+    const uint16_t _p = dev->pend_set ^ dev->pend_ack;
+    dev->pend_ack ^= _p;
+    for (int i = 0; i < usbd_evt_count; i++) {
+        const usbd_evt_callback _cb = usbd_get_evt_callback(dev, i);
+        if ((_p & (1 << i)) && _cb) _cb(dev, i, 0);
+    }
+    if (_p & (1 << USBD_PEND_CTLREQ)) usbd_process_ctlreq(dev);
+}
+#endif
+
+#if defined(USBD_EVENT_QUEUE)
+/** \brief Dispatches events latched by usbd_queue_evt() when the queue was full
+ * \details usbd_queue_evt() is the only writer of the set bits and usbd_process_queue() is the
+ * only writer of the ack bits, same as \ref usbd_latch. Event is pending while bits differ.
+ * \param dev usb device
+ * \return number of the dispatched events
+ */
+static uint8_t usbd_process_overflow(usbd_device *dev) {
+    usbd_evt_queue *const q = &dev->queue;
+    const uint16_t _p = q->pend_set ^ q->pend_ack;
+    uint8_t _n = 0;
+    q->pend_ack ^= _p;
+    for (int i = 0; i < usbd_evt_count; i++) {
+        if (0 == (_p & (1 << i))) continue;
+        q->len = 0;
+        usbd_dispatch_evt(dev, i, 0);
+        _n++;
+    }
+    for (int i = 0; i < 4; i++) {
+        const uint32_t _e = q->pend_ep_set[i] ^ q->pend_ep_ack[i];
+        const uint8_t _evt = USBD_EP_PEND_EVT(i);
+        if (_e == 0) continue;
+        q->pend_ep_ack[i] ^= _e;
+        for (int j = 0; j < 32; j++) {
+            const uint8_t _ep = (j & 0x0F) | ((j & 0x10) << 3);
+            if (0 == (_e & (1UL << j))) continue;
+            /* packet is still in the endpoint buffer */
+            q->len = usbd_peek_len(dev, _evt, _ep);
+            usbd_dispatch_evt(dev, _evt, _ep);
+            _n++;
+        }
+    }
+    return _n;
+}
+
+ __attribute__((externally_visible)) uint8_t usbd_process_queue(usbd_device *dev) {
+    usbd_evt_queue *const q = &dev->queue;
+    const uint8_t _h = q->head;
+    uint8_t _t = q->tail;
+    uint8_t _n = 0;
+    while (_t != _h) {
+        const uint8_t _evt = q->evt[_t & (USBD_EVENT_QUEUE_SIZE - 1)].evt;
+        const uint8_t _ep = q->evt[_t & (USBD_EVENT_QUEUE_SIZE - 1)].ep;
+        q->len = q->evt[_t & (USBD_EVENT_QUEUE_SIZE - 1)].len;
+        /* releasing the slot before the callback, it may take a while */
+        q->tail = ++_t;
+        usbd_dispatch_evt(dev, _evt, _ep);
+        _n++;
+    }
+    return _n + usbd_process_overflow(dev);
+}
+#endif
@@ -0,0 +1,94 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usbd_osal.h"
+
+#if defined(USBD_OSAL) && defined(USBD_OSAL_PTHREAD)
+#include <errno.h>
+#include <time.h>
+
+/** \brief Converts relative timeout to the absolute time */
+static void osal_abstime(struct timespec *ts, uint32_t timeout) {
+    clock_gettime(CLOCK_REALTIME, ts);
+    ts->tv_sec += timeout / 1000;
+    ts->tv_nsec += (long)(timeout % 1000) * 1000000L;
+    if (ts->tv_nsec >= 1000000000L) {
+        ts->tv_sec++;
+        ts->tv_nsec -= 1000000000L;
+    }
+}
+
+static void osal_flags_set(void *obj, uint32_t flags) {
+    struct usbd_osal_pthread *os = obj;
+    pthread_mutex_lock(&os->mutex);
+    os->flags |= flags;
+    pthread_cond_broadcast(&os->cond);
+    pthread_mutex_unlock(&os->mutex);
+}
+
+static uint32_t osal_flags_wait(void *obj, uint32_t flags, uint32_t timeout) {
+    struct usbd_osal_pthread *os = obj;
+    struct timespec ts;
+    uint32_t _r;
+    if (timeout != USBD_OSAL_WAIT_FOREVER) osal_abstime(&ts, timeout);
+    pthread_mutex_lock(&os->mutex);
+    while (!(os->flags & flags)) {
+        if (timeout == USBD_OSAL_WAIT_FOREVER) {
+            pthread_cond_wait(&os->cond, &os->mutex);
+        } else if (pthread_cond_timedwait(&os->cond, &os->mutex, &ts) == ETIMEDOUT) {
+            break;
+        }
+    }
+    _r = os->flags & flags;
+    os->flags &= ~_r;
+    pthread_mutex_unlock(&os->mutex);
+    return _r;
+}
+
+static bool osal_sem_take(void *obj, uint32_t timeout) {
+    struct timespec ts;
+    int _r;
+    if (timeout == USBD_OSAL_WAIT_FOREVER) {
+        while (((_r = sem_wait(obj)) != 0) && (errno == EINTR));
+    } else {
+        osal_abstime(&ts, timeout);
+        while (((_r = sem_timedwait(obj, &ts)) != 0) && (errno == EINTR));
+    }
+    return (_r == 0);
+}
+
+static void osal_sem_give(void *obj) {
+    sem_post(obj);
+}
+
+const struct usbd_osal usbd_osal_pthread = {
+    osal_flags_set,
+    osal_flags_wait,
+    osal_sem_take,
+    osal_sem_give,
+};
+
+ __attribute__((externally_visible)) bool usbd_osal_pthread_init(usbd_device *dev, struct usbd_osal_pthread *os) {
+    os->flags = 0;
+    if (pthread_mutex_init(&os->mutex, 0) != 0) return false;
+    if (pthread_cond_init(&os->cond, 0) != 0) return false;
+    if (sem_init(&os->sem, 0, 1) != 0) return false;
+    usbd_osal_init(dev, &usbd_osal_pthread, os, &os->sem);
+    return true;
+}
+
+#endif //USBD_OSAL_PTHREAD
@@ -1,6 +1,7 @@
 /* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
  *
  * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ * Copyright ©2017 Max Chan <max[at]maxchan[dot]info>
  *
  * Licensed under the Apache License, Version 2.0 (the "License");
  * you may not use this file except in compliance with the License.
@@ -18,22 +19,104 @@
 #include "stm32_compat.h"
 #include "usb.h"
 
-#if defined(USBD_STM32L433)
+#if defined(USBD_STM32L052) || defined(USBD_STM32L433) || defined(USBD_STM32WB55) || \
+    defined(USBD_STM32L100) || defined(USBD_STM32F103)
+
+/* Family traits of the USB FS device core.
+ * DEVFS_RCC_ENR, DEVFS_RCC_RSTR    RCC registers with the USB clock enable and reset bits
+ * DEVFS_RCC_EN, DEVFS_RCC_RST      USB clock enable and reset bits
+ * DEVFS_PMAADDR, DEVFS_BASE        PMA and USB registers base address
+ * PMA_STEP                         PMA halfword step in halfwords. 1 for 1x16, 2 for 2x16 layout
+ * DEVFS_BCDR                       BCDR is present. BC1.2 detection and DP pull-up by BCDR_DPPU
+ * DEVFS_LPM                        LPM (L1) support
+ * DEVFS_PU_PMC                     DP pull-up by SYSCFG_PMC_USB_PU
+ * DEVFS_PU_GPIO                    DP pull-up by USBD_DP_PORT and USBD_DP_PIN if defined
+ * DEVFS_SUSP_ACK_FIRST             clear ISTR_SUSP before setting FSUSP
+ * UID_OFFSET_x                     offsets of the unique device ID words
+ * DEVFS_EPR_WRITE(epr, val)        EPnR write. Overridden by the host-side register model
+ */
+#if defined(USBD_STM32L052)
+    #define DEVFS_RCC_ENR       RCC->APB1ENR
+    #define DEVFS_RCC_RSTR      RCC->APB1RSTR
+    #define DEVFS_RCC_EN        RCC_APB1ENR_USBEN
+    #define DEVFS_RCC_RST       RCC_APB1RSTR_USBRST
+    #define DEVFS_BCDR
+    #define DEVFS_LPM
+    #if defined(STM32F070x6) || defined(STM32F070xB) || \
+        defined(STM32F042x6) || defined(STM32F048xx) || \
+        defined(STM32F072xB) || defined(STM32F078xx)
+    #define UID_OFFSET_2        0x08
+    #endif
+#elif defined(USBD_STM32L433) || defined(USBD_STM32WB55)
+    #if !defined(RCC_APB1ENR1_USBFSEN)
+    #define RCC_APB1ENR1_USBFSEN RCC_APB1ENR1_USBEN
+    #define RCC_APB1RSTR1_USBFSRST RCC_APB1RSTR1_USBRST
+    #endif
+    #define DEVFS_RCC_ENR       RCC->APB1ENR1
+    #define DEVFS_RCC_RSTR      RCC->APB1RSTR1
+    #define DEVFS_RCC_EN        RCC_APB1ENR1_USBFSEN
+    #define DEVFS_RCC_RST       RCC_APB1RSTR1_USBFSRST
+    #define DEVFS_BCDR
+    #define DEVFS_LPM
+    #if defined(USBD_STM32WB55)
+    #define DEVFS_PMAADDR       USB1_PMAADDR
+    #define DEVFS_BASE          USB1_BASE
+    #define DEVFS_SUSP_ACK_FIRST
+    #endif
+#elif defined(USBD_STM32L100)
+    #define DEVFS_RCC_ENR       RCC->APB1ENR
+    #define DEVFS_RCC_RSTR      RCC->APB1RSTR
+    #define DEVFS_RCC_EN        RCC_APB1ENR_USBEN
+    #define DEVFS_RCC_RST       RCC_APB1RSTR_USBRST
+    #define DEVFS_PU_PMC
+    #define PMA_STEP            2
+#elif defined(USBD_STM32F103)
+    #define DEVFS_RCC_ENR       RCC->APB1ENR
+    #define DEVFS_RCC_RSTR      RCC->APB1RSTR
+    #define DEVFS_RCC_EN        RCC_APB1ENR_USBEN
+    #define DEVFS_RCC_RST       RCC_APB1RSTR_USBRST
+    #define DEVFS_PU_GPIO
+    #define UID_OFFSET_2        0x08
+    #if defined(STM32F302x8) || defined(STM32F302xE) || defined(STM32F303xE)
+        #if !defined(USB_PMASIZE)
+        #pragma message "PMA memory size is not defined. Use 768 bytes by default"
+        #define USB_PMASIZE 0x300
+        #endif
+    #else
+        #define PMA_STEP        2
+    #endif
+#endif
 
-#ifndef USB_PMASIZE
+#if !defined(DEVFS_PMAADDR)
+    #define DEVFS_PMAADDR       USB_PMAADDR
+    #define DEVFS_BASE          USB_BASE
+#endif
+
+#if !defined(PMA_STEP)
+    #define PMA_STEP            1
+    #if !defined(USB_PMASIZE)
     #pragma message "PMA memory size is not defined. Use 1k by default"
     #define USB_PMASIZE 0x400
+    #endif
+#elif !defined(USB_PMASIZE)
+    #pragma message "PMA memory size is not defined. Use 512 bytes by default"
+    #define USB_PMASIZE 0x200
 #endif
 
-#if !defined(RCC_APB1ENR1_USBFSEN)
-    #define RCC_APB1ENR1_USBFSEN RCC_APB1ENR1_USBEN
-    #define RCC_APB1RSTR1_USBFSRST RCC_APB1RSTR1_USBRST
+#if !defined(UID_OFFSET_2)
+    #define UID_OFFSET_2        0x14
 #endif
+#define UID_OFFSET_0            0x00
+#define UID_OFFSET_1            0x04
 
 #define USB_EP_SWBUF_TX     USB_EP_DTOG_RX
 #define USB_EP_SWBUF_RX     USB_EP_DTOG_TX
 
-#define EP_TOGGLE_SET(epr, bits, mask) *(epr) = (*(epr) ^ (bits)) & (USB_EPREG_MASK | (mask))
+#if !defined(DEVFS_EPR_WRITE)
+    #define DEVFS_EPR_WRITE(epr, val)   *(epr) = (val)
+#endif
+
+#define EP_TOGGLE_SET(epr, bits, mask) DEVFS_EPR_WRITE((epr), (*(epr) ^ (bits)) & (USB_EPREG_MASK | (mask)))
 
 #define EP_TX_STALL(epr)    EP_TOGGLE_SET((epr), USB_EP_TX_STALL,                   USB_EPTX_STAT)
 #define EP_RX_STALL(epr)    EP_TOGGLE_SET((epr), USB_EP_RX_STALL,                   USB_EPRX_STAT)
@@ -44,12 +127,25 @@
 #define EP_TX_VALID(epr)    EP_TOGGLE_SET((epr), USB_EP_TX_VALID,                   USB_EPTX_STAT)
 #define EP_RX_VALID(epr)    EP_TOGGLE_SET((epr), USB_EP_RX_VALID,                   USB_EPRX_STAT)
 
-#define STATUS_VAL(x)   (USBD_HW_BC | (x))
+#if defined(DEVFS_BCDR)
+    #define STATUS_VAL(x)   (USBD_HW_BC | (x))
+#else
+    #define STATUS_VAL(x)   (x)
+#endif
 
+#if (PMA_STEP == 1)
 typedef struct {
     uint16_t    addr;
     uint16_t    cnt;
 } pma_rec;
+#else
+typedef struct {
+    uint16_t    addr;
+    uint16_t    :16;
+    uint16_t    cnt;
+    uint16_t    :16;
+} pma_rec;
+#endif
 
 typedef union pma_table {
     struct {
@@ -70,16 +166,59 @@ typedef union pma_table {
 /** \brief Helper function. Returns pointer to the buffer descriptor table.
  */
 inline static pma_table *EPT(uint8_t ep) {
-    return (pma_table*)((ep & 0x07) * 8 + USB_PMAADDR);
+    return (pma_table*)((ep & 0x07) * 8 * PMA_STEP + DEVFS_PMAADDR);
+}
 
+/** \brief Helper function. Returns pointer to the PMA buffer.
+ */
+inline static uint16_t *PMA(uint16_t addr) {
+    return (uint16_t*)(DEVFS_PMAADDR + PMA_STEP * addr);
 }
 
 /** \brief Helper function. Returns pointer to the endpoint control register.
  */
 inline static volatile uint16_t *EPR(uint8_t ep) {
-    return (uint16_t*)((ep & 0x07) * 4 + USB_BASE);
+    return (uint16_t*)((ep & 0x07) * 4 + DEVFS_BASE);
 }
 
+#if defined(DEVFS_PU_GPIO)
+/** \brief Helper function. Enables GPIOx for DP.
+ * Looks ugly. But compiler should optimize this
+ * to single line
+ */
+inline static void set_gpiox() {
+#if defined(STM32F1) && defined(USBD_DP_PORT)
+    if (USBD_DP_PORT == GPIOA) {RCC->APB2ENR |= RCC_APB2ENR_IOPAEN; return;}
+    if (USBD_DP_PORT == GPIOB) {RCC->APB2ENR |= RCC_APB2ENR_IOPBEN; return;}
+    if (USBD_DP_PORT == GPIOC) {RCC->APB2ENR |= RCC_APB2ENR_IOPCEN; return;}
+    if (USBD_DP_PORT == GPIOD) {RCC->APB2ENR |= RCC_APB2ENR_IOPDEN; return;}
+    #if defined(GPIOE)
+    if (USBD_DP_PORT == GPIOE) {RCC->APB2ENR |= RCC_APB2ENR_IOPEEN; return;}
+    #endif
+    #if defined(GPIOF)
+    if (USBD_DP_PORT == GPIOF) {RCC->APB2ENR |= RCC_APB2ENR_IOPFEN; return;}
+    #endif
+#elif defined(STM32F3) && defined(USBD_DP_PORT)
+    if (USBD_DP_PORT == GPIOA) {RCC->AHBENR |= RCC_AHBENR_GPIOAEN; return;}
+    if (USBD_DP_PORT == GPIOB) {RCC->AHBENR |= RCC_AHBENR_GPIOBEN; return;}
+    if (USBD_DP_PORT == GPIOC) {RCC->AHBENR |= RCC_AHBENR_GPIOCEN; return;}
+    if (USBD_DP_PORT == GPIOD) {RCC->AHBENR |= RCC_AHBENR_GPIODEN; return;}
+    #if defined(GPIOE)
+    if (USBD_DP_PORT == GPIOE) {RCC->AHBENR |= RCC_AHBENR_GPIOEEN; return;}
+    #endif
+    #if defined(GPIOF)
+    if (USBD_DP_PORT == GPIOF) {RCC->AHBENR |= RCC_AHBENR_GPIOFEN; return;}
+    #endif
+    #if defined(GPIOG)
+    if (USBD_DP_PORT == GPIOG) {RCC->AHBENR |= RCC_AHBENR_GPIOGEN; return;}
+    #endif
+    #if defined(GPIOH)
+    if (USBD_DP_PORT == GPIOH) {RCC->AHBENR |= RCC_AHBENR_GPIOHEN; return;}
+    #endif
+#endif
+    return;
+}
+#endif
 
 /** \brief Helper function. Returns next available PMA buffer.
  *
@@ -98,8 +237,16 @@ static uint16_t get_next_pma(uint16_t sz) {
 }
 
 static uint32_t getinfo(void) {
-    if (!(RCC->APB1ENR1 & RCC_APB1ENR1_USBFSEN)) return STATUS_VAL(0);
+    if (!(DEVFS_RCC_ENR & DEVFS_RCC_EN)) return STATUS_VAL(0);
+#if defined(DEVFS_BCDR)
     if (USB->BCDR & USB_BCDR_DPPU) return STATUS_VAL(USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+#elif defined(DEVFS_PU_PMC)
+    if (SYSCFG->PMC & SYSCFG_PMC_USB_PU) return STATUS_VAL(USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+#elif defined(USBD_DP_PORT) && defined(USBD_DP_PIN)
+    if (USBD_DP_PORT->IDR & _BV(USBD_DP_PIN)) return STATUS_VAL(USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+#else
+    return STATUS_VAL(USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+#endif
     return STATUS_VAL(USBD_HW_ENABLED);
 }
 
@@ -148,24 +295,8 @@ static bool ep_isstalled(uint8_t ep) {
     }
 }
 
-static void enable(bool enable) {
-    if (enable) {
-        RCC->APB1ENR1  |=  RCC_APB1ENR1_USBFSEN;
-        RCC->APB1RSTR1 |= RCC_APB1RSTR1_USBFSRST;
-        RCC->APB1RSTR1 &= ~RCC_APB1RSTR1_USBFSRST;
-        USB->CNTR = USB_CNTR_CTRM | USB_CNTR_RESETM | USB_CNTR_ERRM |
-#if !defined(USBD_SOF_DISABLED)
-        USB_CNTR_SOFM |
-#endif
-        USB_CNTR_SUSPM | USB_CNTR_WKUPM;
-    } else if (RCC->APB1ENR1 & RCC_APB1ENR1_USBFSEN) {
-        USB->BCDR = 0;
-        RCC->APB1RSTR1 |= RCC_APB1RSTR1_USBFSRST;
-        RCC->APB1ENR1 &= ~RCC_APB1ENR1_USBFSEN;
-    }
-}
-
 static uint8_t connect(bool connect) {
+#if defined(DEVFS_BCDR)
     uint8_t res;
     USB->BCDR = USB_BCDR_BCDEN | USB_BCDR_DCDEN;
     if (USB->BCDR & USB_BCDR_DCDET) {
@@ -187,6 +318,78 @@ static uint8_t connect(bool connect) {
     }
     USB->BCDR = (connect) ? USB_BCDR_DPPU : 0;
     return res;
+#else
+#if defined(DEVFS_PU_PMC)
+    if (connect) {
+        SYSCFG->PMC |= SYSCFG_PMC_USB_PU;
+    } else {
+        SYSCFG->PMC &= ~SYSCFG_PMC_USB_PU;
+    }
+#elif defined(USBD_DP_PORT) && defined(USBD_DP_PIN) && defined(STM32F3)
+    uint32_t _t = USBD_DP_PORT->MODER & ~(0x03 << (2 * USBD_DP_PIN));
+    if (connect) {
+        _t |= (0x01 << (2 * USBD_DP_PIN));
+        USBD_DP_PORT->BSRR = (0x0001 << USBD_DP_PIN);
+    }
+    USBD_DP_PORT->MODER = _t;
+#elif defined(USBD_DP_PORT) && defined(USBD_DP_PIN) && defined(STM32F1)
+#if (USBD_DP_PIN < 8)
+    uint32_t _t = USBD_DP_PORT->CRL & ~(0x0F << (4 * USBD_DP_PIN));
+    if (connect) {
+        _t |= (0x02 << (4 * USBD_DP_PIN));
+        USBD_DP_PORT->BSRR = (0x0001 << USBD_DP_PIN);
+    } else {
+        _t |= (0x04 << (4 * USBD_DP_PIN));
+    }
+    USBD_DP_PORT->CRL = _t;
+#else
+    uint32_t _t = USBD_DP_PORT->CRH & ~(0x0F << (4 * (USBD_DP_PIN - 8)));
+    if (connect) {
+        _t |= (0x02 << (4 * (USBD_DP_PIN - 8)));
+        USBD_DP_PORT->BSRR = (0x0001 << USBD_DP_PIN);
+    } else {
+       _t |= (0x04 << (4 * (USBD_DP_PIN - 8)));
+    }
+    USBD_DP_PORT->CRH = _t;
+#endif
+#endif
+    return usbd_lane_unk;
+#endif
+}
+
+static void enable(bool enable) {
+    if (enable) {
+#if defined(DEVFS_PU_GPIO)
+        set_gpiox();
+#endif
+        DEVFS_RCC_ENR  |= DEVFS_RCC_EN;
+#if defined(DEVFS_PU_PMC)
+        RCC->APB2ENR   |= RCC_APB2ENR_SYSCFGEN;
+#endif
+        DEVFS_RCC_RSTR |= DEVFS_RCC_RST;
+        DEVFS_RCC_RSTR &= ~DEVFS_RCC_RST;
+#if defined(USBD_PINS_REMAP) && (defined(STM32F042x6) || defined(STM32F048xx) || defined(STM32F070x6))
+        RCC->APB2ENR  |= RCC_APB2ENR_SYSCFGCOMPEN;
+        SYSCFG->CFGR1 |= SYSCFG_CFGR1_PA11_PA12_RMP;	// remap USB pins for small packages
+#endif
+        USB->CNTR = USB_CNTR_CTRM | USB_CNTR_RESETM | USB_CNTR_ERRM |
+#if !defined(USBD_SOF_DISABLED)
+        USB_CNTR_SOFM |
+#endif
+        USB_CNTR_SUSPM | USB_CNTR_WKUPM;
+    } else if (DEVFS_RCC_ENR & DEVFS_RCC_EN) {
+#if defined(DEVFS_BCDR)
+        USB->BCDR = 0;
+#elif defined(DEVFS_PU_PMC)
+        SYSCFG->PMC &= ~SYSCFG_PMC_USB_PU;
+#endif
+        DEVFS_RCC_RSTR |= DEVFS_RCC_RST;
+        DEVFS_RCC_ENR  &= ~DEVFS_RCC_EN;
+#if defined(DEVFS_PU_GPIO)
+        /* disconnecting DP if configured */
+        connect(0);
+#endif
+    }
 }
 
 static void setaddr (uint8_t addr) {
@@ -201,19 +404,19 @@ static bool ep_config(uint8_t ep, uint8_t eptype, uint16_t epsize) {
 
     switch (eptype) {
     case USB_EPTYPE_CONTROL:
-        *reg = USB_EP_CONTROL | (ep & 0x07);
+        DEVFS_EPR_WRITE(reg, USB_EP_CONTROL | (ep & 0x07));
         break;
     case USB_EPTYPE_ISOCHRONUS:
-        *reg = USB_EP_ISOCHRONOUS | (ep & 0x07);
+        DEVFS_EPR_WRITE(reg, USB_EP_ISOCHRONOUS | (ep & 0x07));
         break;
     case USB_EPTYPE_BULK:
-        *reg = USB_EP_BULK | (ep & 0x07);
+        DEVFS_EPR_WRITE(reg, USB_EP_BULK | (ep & 0x07));
         break;
     case USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF:
-        *reg = USB_EP_BULK | USB_EP_KIND | (ep & 0x07);
+        DEVFS_EPR_WRITE(reg, USB_EP_BULK | USB_EP_KIND | (ep & 0x07));
         break;
     default:
-        *reg = USB_EP_INTERRUPT | (ep & 0x07);
+        DEVFS_EPR_WRITE(reg, USB_EP_INTERRUPT | (ep & 0x07));
         break;
     }
     /* if it TX or CONTROL endpoint */
@@ -264,7 +467,7 @@ static bool ep_config(uint8_t ep, uint8_t eptype, uint16_t epsize) {
 
 static void ep_deconfig(uint8_t ep) {
     pma_table *ept = EPT(ep);
-    *EPR(ep) &= ~USB_EPREG_MASK;
+    DEVFS_EPR_WRITE(EPR(ep), *EPR(ep) & ~USB_EPREG_MASK);
     ept->rx.addr = 0;
     ept->rx.cnt  = 0;
     ept->tx.addr = 0;
@@ -272,7 +475,7 @@ static void ep_deconfig(uint8_t ep) {
 }
 
 static uint16_t pma_read (uint8_t *buf, uint16_t blen, pma_rec *rx) {
-    uint16_t *pma = (void*)(USB_PMAADDR + rx->addr);
+    uint16_t *pma = PMA(rx->addr);
     uint16_t rxcnt = rx->cnt & 0x03FF;
     rx->cnt &= ~0x3FF;
 
@@ -285,7 +488,7 @@ static uint16_t pma_read (uint8_t *buf, uint16_t blen, pma_rec *rx) {
         *buf++ = _t & 0xFF;
         if (--blen) {
             *buf++ = _t >> 8;
-            pma++;
+            pma += PMA_STEP;
             blen--;
         } else break;
     }
@@ -302,7 +505,7 @@ static int32_t ep_read(uint8_t ep, void *buf, uint16_t blen) {
         switch (*reg & (USB_EP_DTOG_RX | USB_EP_SWBUF_RX)) {
         case 0:
         case (USB_EP_DTOG_RX | USB_EP_SWBUF_RX):
-            *reg = (*reg & USB_EPREG_MASK) | USB_EP_SWBUF_RX;
+            DEVFS_EPR_WRITE(reg, (*reg & USB_EPREG_MASK) | USB_EP_SWBUF_RX);
         	break;
         default:
             break;
@@ -335,11 +538,41 @@ static int32_t ep_read(uint8_t ep, void *buf, uint16_t blen) {
     }
 }
 
+static int32_t ep_peek(uint8_t ep) {
+    pma_table *tbl = EPT(ep);
+    volatile uint16_t *reg = EPR(ep);
+    switch (*reg & (USB_EPRX_STAT | USB_EP_T_FIELD | USB_EP_KIND)) {
+    /* doublebuffered bulk endpoint. ep_read takes the buffer opposite to DTOG_RX */
+    case (USB_EP_RX_VALID | USB_EP_BULK | USB_EP_KIND):
+        if (*reg & USB_EP_DTOG_RX) {
+            return tbl->rx0.cnt & 0x03FF;
+        } else {
+            return tbl->rx1.cnt & 0x03FF;
+        }
+    /* isochronous endpoint */
+    case (USB_EP_RX_VALID | USB_EP_ISOCHRONOUS):
+        if (*reg & USB_EP_DTOG_RX) {
+            return tbl->rx1.cnt & 0x03FF;
+        } else {
+            return tbl->rx0.cnt & 0x03FF;
+        }
+    /* regular endpoint */
+    case (USB_EP_RX_NAK | USB_EP_BULK):
+    case (USB_EP_RX_NAK | USB_EP_CONTROL):
+    case (USB_EP_RX_NAK | USB_EP_INTERRUPT):
+        return tbl->rx.cnt & 0x03FF;
+    /* invalid or not ready */
+    default:
+        return -1;
+    }
+}
+
 static void pma_write(const uint8_t *buf, uint16_t blen, pma_rec *tx) {
-    uint16_t *pma = (void*)(USB_PMAADDR + tx->addr);
+    uint16_t *pma = PMA(tx->addr);
     tx->cnt = blen;
     while (blen > 1) {
-        *pma++ = buf[1] << 8 | buf[0];
+        *pma = buf[1] << 8 | buf[0];
+        pma += PMA_STEP;
         buf += 2;
         blen -= 2;
     }
@@ -357,7 +590,7 @@ static int32_t ep_write(uint8_t ep, const void *buf, uint16_t blen) {
         } else {
             pma_write(buf, blen, &(tbl->tx0));
         }
-        *reg = (*reg & USB_EPREG_MASK) | USB_EP_SWBUF_TX;
+        DEVFS_EPR_WRITE(reg, (*reg & USB_EPREG_MASK) | USB_EP_SWBUF_TX);
         break;
     /* isochronous endpoint */
     case (USB_EP_TX_VALID | USB_EP_ISOCHRONOUS):
@@ -385,6 +618,43 @@ static uint16_t get_frame (void) {
     return USB->FNR & USB_FNR_FN;
 }
 
+/* RESUME signaling length in ESOF periods (1ms each). Must be 1-15ms */
+#define RESUME_ESOF_COUNT   3
+static volatile uint8_t resume_count;
+
+#if defined(DEVFS_LPM)
+static volatile bool l1_sleep;
+
+static void lpm_config(bool enable, uint8_t besl) {
+    (void)besl;
+    if (enable) {
+        USB->LPMCSR = USB_LPMCSR_LMPEN | USB_LPMCSR_LPMACK;
+        USB->CNTR |= USB_CNTR_L1REQM;
+    } else {
+        USB->CNTR &= ~USB_CNTR_L1REQM;
+        USB->LPMCSR = 0;
+    }
+}
+#endif
+
+static bool remote_wakeup(void) {
+#if defined(DEVFS_LPM)
+    if (l1_sleep) {
+        /* L1 resume signaling is timed by hardware. Host allows it in the LPM token */
+        if (!(USB->LPMCSR & USB_LPMCSR_REMWAKE)) return false;
+        l1_sleep = false;
+        USB->CNTR &= ~(USB_CNTR_LPMODE | USB_CNTR_FSUSP);
+        USB->CNTR |= USB_CNTR_L1RESUME;
+        return true;
+    }
+#endif
+    USB->CNTR &= ~(USB_CNTR_LPMODE | USB_CNTR_FSUSP);
+    USB->ISTR &= ~USB_ISTR_ESOF;
+    resume_count = RESUME_ESOF_COUNT;
+    USB->CNTR |= USB_CNTR_RESUME | USB_CNTR_ESOFM;
+    return true;
+}
+
 static void evt_poll(usbd_device *dev, usbd_evt_callback callback) {
     uint8_t _ev, _ep;
     uint16_t _istr = USB->ISTR;
@@ -392,16 +662,19 @@ static void evt_poll(usbd_device *dev, usbd_evt_callback callback) {
     if (_istr & USB_ISTR_CTR) {
         volatile uint16_t *reg = EPR(_ep);
         if (*reg & USB_EP_CTR_TX) {
-            *reg &= (USB_EPREG_MASK ^ USB_EP_CTR_TX);
+            DEVFS_EPR_WRITE(reg, *reg & (USB_EPREG_MASK ^ USB_EP_CTR_TX));
             _ep |= 0x80;
             _ev = usbd_evt_eptx;
         } else {
-            *reg &= (USB_EPREG_MASK ^ USB_EP_CTR_RX);
+            DEVFS_EPR_WRITE(reg, *reg & (USB_EPREG_MASK ^ USB_EP_CTR_RX));
             _ev = (*reg & USB_EP_SETUP) ? usbd_evt_epsetup : usbd_evt_eprx;
         }
     } else if (_istr & USB_ISTR_RESET) {
         USB->ISTR &= ~USB_ISTR_RESET;
         USB->BTABLE = 0;
+#if defined(DEVFS_LPM)
+        l1_sleep = false;
+#endif
         for (int i = 0; i < 8; i++) {
             ep_deconfig(i);
         }
@@ -412,13 +685,44 @@ static void evt_poll(usbd_device *dev, usbd_evt_callback callback) {
         USB->ISTR &= ~USB_ISTR_SOF;
 #endif
     } else if (_istr & USB_ISTR_WKUP) {
+#if defined(DEVFS_LPM)
+        _ev = l1_sleep ? usbd_evt_l1wkup : usbd_evt_wkup;
+        l1_sleep = false;
+#else
         _ev = usbd_evt_wkup;
+#endif
         USB->CNTR &= ~USB_CNTR_FSUSP;
         USB->ISTR &= ~USB_ISTR_WKUP;
     } else if (_istr & USB_ISTR_SUSP) {
         _ev = usbd_evt_susp;
+#if defined(DEVFS_SUSP_ACK_FIRST)
+        USB->ISTR &= ~USB_ISTR_SUSP;
+#endif
         USB->CNTR |= USB_CNTR_FSUSP;
+#if defined(USBD_SUSPEND_LOWPOWER)
+        USB->CNTR |= USB_CNTR_LPMODE;
+#endif
+#if !defined(DEVFS_SUSP_ACK_FIRST)
         USB->ISTR &= ~USB_ISTR_SUSP;
+#endif
+#if defined(DEVFS_LPM)
+    } else if (_istr & USB_ISTR_L1REQ) {
+        /* L1 sleep is acknowledged by hardware. Entering the same way as suspend */
+        _ev = usbd_evt_l1susp;
+        l1_sleep = true;
+        USB->ISTR &= ~USB_ISTR_L1REQ;
+        USB->CNTR |= USB_CNTR_FSUSP;
+#if defined(USBD_SUSPEND_LOWPOWER)
+        USB->CNTR |= USB_CNTR_LPMODE;
+#endif
+#endif
+    } else if ((_istr & USB_ISTR_ESOF) && (USB->CNTR & USB_CNTR_ESOFM)) {
+        USB->ISTR &= ~USB_ISTR_ESOF;
+        /* counting RESUME signaling length */
+        if (--resume_count == 0) {
+            USB->CNTR &= ~(USB_CNTR_RESUME | USB_CNTR_ESOFM);
+        }
+        return;
     } else if (_istr & USB_ISTR_ERR) {
         USB->ISTR &= ~USB_ISTR_ERR;
         _ev = usbd_evt_error;
@@ -441,9 +745,9 @@ static uint16_t get_serialno_desc(void *buffer) {
     struct  usb_string_descriptor *dsc = buffer;
     uint16_t *str = dsc->wString;
     uint32_t fnv = 2166136261;
-    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x00));
-    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x04));
-    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x14));
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + UID_OFFSET_0));
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + UID_OFFSET_1));
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + UID_OFFSET_2));
     for (int i = 28; i >= 0; i -= 4 ) {
         uint16_t c = (fnv >> i) & 0x0F;
         c += (c < 10) ? '0' : ('A' - 10);
@@ -468,6 +772,14 @@ static uint16_t get_serialno_desc(void *buffer) {
     evt_poll,
     get_frame,
     get_serialno_desc,
+    remote_wakeup,
+#if defined(DEVFS_LPM)
+    lpm_config,
+#else
+    0,
+#endif
+    0,
+    ep_peek,
 };
 
-#endif //USBD_STM32L052
+#endif //USBD_STM32L052 || USBD_STM32L433 || USBD_STM32WB55 || USBD_STM32L100 || USBD_STM32F103
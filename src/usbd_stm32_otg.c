@@ -0,0 +1,1111 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ * STM32F105 support by Fabian Inostroza
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "stm32_compat.h"
+#include "usb.h"
+
+#if defined(USBD_STM32F429FS) || defined(USBD_STM32F429HS) || defined(USBD_STM32F105) || \
+    defined(USBD_STM32F446FS) || defined(USBD_STM32F446HS) || defined(USBD_STM32L476) || \
+    defined(USBD_STM32H743FS)
+
+/* Family traits of the Synopsys OTG core.
+ * OTG_GCCFG_LEGACY     VBUS sensing by GCCFG_VBUSBSEN, PHY is powered up on connect
+ * OTG_NOVBUSSENS       GCCFG bit to disable VBUS sensing for the legacy cores
+ * OTG_LPM              LPM (L1) support
+ * OTG_BCD              BC1.2 detection by GCCFG
+ * OTG_HCLK             maximum core clock, default for USBD_HCLK
+ */
+#if defined(USBD_STM32F429FS) || defined(USBD_STM32F429HS)
+    #define OTG_GCCFG_LEGACY
+    #define OTG_NOVBUSSENS  USB_OTG_GCCFG_NOVBUSSENS
+    #define OTG_HCLK        180000000
+#elif defined(USBD_STM32F105)
+    #define OTG_GCCFG_LEGACY
+    #define OTG_NOVBUSSENS  0
+    #define OTG_HCLK        72000000
+#elif defined(USBD_STM32F446FS) || defined(USBD_STM32F446HS)
+    #define OTG_LPM
+    #define OTG_HCLK        216000000   /* F7 */
+#elif defined(USBD_STM32L476)
+    #define OTG_LPM
+    #define OTG_BCD
+    #define OTG_HCLK        80000000
+#elif defined(USBD_STM32H743FS)
+    #define OTG_LPM
+    #define OTG_HCLK        480000000
+#endif
+
+#if !defined(USBD_HCLK)
+    #define USBD_HCLK       OTG_HCLK
+#endif
+
+#if defined(USBD_STM32F446HS)
+#define MAX_EP          9    /* largest endpoint count of the OTG cores */
+#else
+#define MAX_EP          6
+#endif
+#define MAX_RX_PACKET   128
+#define MAX_CONTROL_EP  1
+
+#if defined(OTG_BCD)
+#define STATUS_VAL(x)   (USBD_HW_BC | USBD_HW_ADDRFST | (x))
+#else
+#define STATUS_VAL(x)   (USBD_HW_ADDRFST | (x))
+#endif
+
+#define FIFO_WORDS(x)   (((x) + 0x03) >> 2)
+
+/* default RX FIFO size in 32-bit chunks for the given packet size and endpoints count */
+#define RX_FIFO_SZ(pkt, eps)    ((4 * MAX_CONTROL_EP + 6) + (((pkt) / 4) + 1) + ((eps) * 2) + 1)
+
+#define OTG_PHY_FS      0    /**<\brief FS core with embedded FS PHY.*/
+#define OTG_PHY_HSFS    1    /**<\brief HS core with embedded FS PHY.*/
+#define OTG_PHY_ULPI    2    /**<\brief HS core with external ULPI PHY.*/
+
+/**\brief OTG core instance context.
+ * \details All OTG cores share the same driver code. Each core is described by it's own
+ * context, bound to the \ref usbd_driver table of this core.
+ */
+struct otg_core {
+    uint32_t            base;       /**<\brief Core base address.*/
+    volatile uint32_t  *rcc_enr;    /**<\brief RCC clock enable register.*/
+    volatile uint32_t  *rcc_rstr;   /**<\brief RCC reset register.*/
+    uint32_t            rcc_en;     /**<\brief Clock enable bits.*/
+    uint32_t            rcc_rst;    /**<\brief Reset bit.*/
+    void              (*clock)(bool enable); /**<\brief SoC specific clock and power setup. Optional.*/
+    uint32_t            gusbcfg;    /**<\brief GUSBCFG value. PHY selection and turnaround time.*/
+    uint16_t            max_fifo;   /**<\brief FIFO RAM size in 32-bit chunks.*/
+    uint16_t            rx_fifo;    /**<\brief Default RX FIFO size in 32-bit chunks.*/
+    uint16_t            rx_packet;  /**<\brief Default OUT packet size for the FIFO plan.*/
+    uint8_t             max_ep;     /**<\brief Number of the endpoints.*/
+    uint8_t             phy;        /**<\brief PHY variant. OTG_PHY_FS, OTG_PHY_HSFS or OTG_PHY_ULPI.*/
+    uint16_t            fifo_rx;    /**<\brief Planned RX FIFO size. 0 if no plan applied.*/
+    uint32_t            fifo_tx[MAX_EP]; /**<\brief Planned DIEPTXFx values.*/
+    uint32_t            rx_tsize[MAX_EP]; /**<\brief DOEPTSIZx for one (micro)frame. 0 if not used.*/
+    volatile uint16_t   tx_pend[MAX_EP]; /**<\brief Preloaded IN packet size + 1. 0 if none.*/
+    uint16_t            tx_dblbuf;  /**<\brief Doublebuffered IN endpoints mask.*/
+    volatile bool       rx_pending; /**<\brief RX FIFO head packet is not read by the callback.*/
+#if defined(OTG_LPM)
+    volatile bool       l1_sleep;   /**<\brief Core is in L1 sleep state.*/
+#endif
+};
+
+inline static USB_OTG_GlobalTypeDef* OTG(struct otg_core *c) {
+    return (void*)(c->base + USB_OTG_GLOBAL_BASE);
+}
+
+inline static USB_OTG_DeviceTypeDef* OTGD(struct otg_core *c) {
+    return (void*)(c->base + USB_OTG_DEVICE_BASE);
+}
+
+inline static volatile uint32_t* OTGPCTL(struct otg_core *c) {
+    return (void*)(c->base + USB_OTG_PCGCCTL_BASE);
+}
+
+inline static uint32_t* EPFIFO(struct otg_core *c, uint32_t ep) {
+    return (uint32_t*)(c->base + USB_OTG_FIFO_BASE + (ep << 12));
+}
+
+inline static USB_OTG_INEndpointTypeDef* EPIN(struct otg_core *c, uint32_t ep) {
+    return (void*)(c->base + USB_OTG_IN_ENDPOINT_BASE + (ep << 5));
+}
+
+inline static USB_OTG_OUTEndpointTypeDef* EPOUT(struct otg_core *c, uint32_t ep) {
+    return (void*)(c->base + USB_OTG_OUT_ENDPOINT_BASE + (ep << 5));
+}
+
+inline static void Flush_RX(struct otg_core *c) {
+    _BST(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_RXFFLSH);
+    _WBC(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_RXFFLSH);
+}
+
+inline static void Flush_TX(struct otg_core *c, uint8_t ep) {
+    _BMD(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_TXFNUM,
+         _VAL2FLD(USB_OTG_GRSTCTL_TXFNUM, ep) | USB_OTG_GRSTCTL_TXFFLSH);
+    _WBC(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_TXFFLSH);
+}
+
+/**\brief Helper. Sets up RX and EP0 TX FIFO by the FIFO plan or default allocation */
+static void fifo_setup(struct otg_core *c) {
+    /* setting max RX FIFO size */
+    OTG(c)->GRXFSIZ = (c->fifo_rx) ? c->fifo_rx : c->rx_fifo;
+    /* setting up EP0 TX FIFO SZ as 64 byte */
+    OTG(c)->DIEPTXF0_HNPTXFSIZ = (c->fifo_rx) ? c->fifo_tx[0] : (c->rx_fifo | (0x10 << 16));
+}
+
+static uint32_t getinfo(struct otg_core *c) {
+    uint32_t _caps = (c->phy == OTG_PHY_ULPI) ? USBD_HW_HS : 0;
+    if (!(*c->rcc_enr & c->rcc_en)) return STATUS_VAL(_caps);
+    if (!(OTGD(c)->DCTL & USB_OTG_DCTL_SDIS)) {
+        if (c->phy == OTG_PHY_FS) return STATUS_VAL(USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+        switch (_FLD2VAL(USB_OTG_DSTS_ENUMSPD, OTGD(c)->DSTS)) {
+        case 0x00:  /* high speed. ULPI PHY only */
+            return STATUS_VAL(_caps | USBD_HW_ENABLED | USBD_HW_SPEED_HS);
+        case 0x01:  /* full speed. ULPI PHY */
+        case 0x03:  /* full speed. internal PHY */
+            return STATUS_VAL(_caps | USBD_HW_ENABLED | USBD_HW_SPEED_FS);
+        default:
+            break;
+        }
+    }
+    return STATUS_VAL(_caps | USBD_HW_ENABLED);
+}
+
+static void ep_setstall(struct otg_core *c, uint8_t ep, bool stall) {
+    if (ep & 0x80) {
+        ep &= 0x7F;
+        uint32_t _t = EPIN(c, ep)->DIEPCTL;
+        if (_t & USB_OTG_DIEPCTL_USBAEP) {
+            if (stall) {
+                _BST(_t, USB_OTG_DIEPCTL_STALL);
+            } else {
+                _BMD(_t, USB_OTG_DIEPCTL_STALL,
+                     USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_SNAK);
+            }
+            EPIN(c, ep)->DIEPCTL = _t;
+        }
+    } else {
+        uint32_t _t = EPOUT(c, ep)->DOEPCTL;
+        if (_t & USB_OTG_DOEPCTL_USBAEP) {
+            if (stall) {
+                _BST(_t, USB_OTG_DOEPCTL_STALL);
+            } else {
+                _BMD(_t, USB_OTG_DOEPCTL_STALL,
+                     USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_CNAK);
+            }
+            EPOUT(c, ep)->DOEPCTL = _t;
+        }
+    }
+}
+
+static bool ep_isstalled(struct otg_core *c, uint8_t ep) {
+    if (ep & 0x80) {
+        ep &= 0x7F;
+        return (EPIN(c, ep)->DIEPCTL & USB_OTG_DIEPCTL_STALL) ? true : false;
+    } else {
+        return (EPOUT(c, ep)->DOEPCTL & USB_OTG_DOEPCTL_STALL) ? true : false;
+    }
+}
+
+static void enable(struct otg_core *c, bool enable) {
+    if (enable) {
+        /* enabling USB_OTG in RCC */
+        _BST(*c->rcc_enr, c->rcc_en);
+        if (c->clock) c->clock(true);
+        /* waiting AHB ready */
+        _WBS(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_AHBIDL);
+        /* configure OTG as device and select PHY */
+        OTG(c)->GUSBCFG = c->gusbcfg;
+        /* do core soft reset to switch PHY */
+        _BST(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_CSRST);
+        _WBC(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_CSRST);
+        _WBS(OTG(c)->GRSTCTL, USB_OTG_GRSTCTL_AHBIDL);
+        /* configuring Vbus sense, SOF output and powerup PHY */
+#if defined(OTG_GCCFG_LEGACY)
+/* VBUS detect alternafe function AF12 for PB13 is missed in tech documentation */
+#if defined (USBD_VBUS_DETECT) && defined(USBD_SOF_OUT)
+        OTG(c)->GCCFG = USB_OTG_GCCFG_VBUSBSEN | USB_OTG_GCCFG_SOFOUTEN;
+#elif defined(USBD_VBUS_DETECT)
+        OTG(c)->GCCFG = USB_OTG_GCCFG_VBUSBSEN;
+#elif defined(USBD_SOF_OUT)
+        OTG(c)->GCCFG = OTG_NOVBUSSENS | USB_OTG_GCCFG_SOFOUTEN;
+#else
+        OTG(c)->GCCFG = OTG_NOVBUSSENS;
+#endif
+#else
+        if (c->phy == OTG_PHY_ULPI) {
+            /* VBUS is sensed by the PHY. internal FS PHY stays powered down */
+            OTG(c)->GCCFG = 0;
+#if !defined(USBD_VBUS_DETECT)
+            OTG(c)->GOTGCTL |= USB_OTG_GOTGCTL_BVALOEN | USB_OTG_GOTGCTL_BVALOVAL;
+#endif
+        } else {
+#if defined(USBD_VBUS_DETECT)
+            OTG(c)->GCCFG |= USB_OTG_GCCFG_VBDEN | USB_OTG_GCCFG_PWRDWN;
+#else
+            OTG(c)->GOTGCTL |= USB_OTG_GOTGCTL_BVALOEN | USB_OTG_GOTGCTL_BVALOVAL;
+            OTG(c)->GCCFG = USB_OTG_GCCFG_PWRDWN;
+#endif
+        }
+#endif
+        /* enable PHY clock */
+        *OTGPCTL(c) = 0;
+        /* soft disconnect device */
+        _BST(OTGD(c)->DCTL, USB_OTG_DCTL_SDIS);
+        /* Setup USB speed and frame interval */
+        _BMD(OTGD(c)->DCFG, USB_OTG_DCFG_PERSCHIVL | USB_OTG_DCFG_DSPD,
+             _VAL2FLD(USB_OTG_DCFG_PERSCHIVL, 0) |
+             _VAL2FLD(USB_OTG_DCFG_DSPD, (c->phy == OTG_PHY_ULPI) ? 0x00 : 0x03));
+        fifo_setup(c);
+        /* unmask EP interrupts */
+        OTGD(c)->DIEPMSK = USB_OTG_DIEPMSK_XFRCM;
+        /* unmask core interrupts */
+        OTG(c)->GINTMSK  = USB_OTG_GINTMSK_USBRST | USB_OTG_GINTMSK_ENUMDNEM |
+#if !defined(USBD_SOF_DISABLED)
+                           USB_OTG_GINTMSK_SOFM |
+#endif
+                           USB_OTG_GINTMSK_USBSUSPM | USB_OTG_GINTMSK_WUIM |
+                           USB_OTG_GINTMSK_IEPINT | USB_OTG_GINTMSK_RXFLVLM |
+                           USB_OTG_GINTMSK_IISOIXFRM | USB_OTG_GINTMSK_PXFRM_IISOOXFRM;
+        /* clear pending interrupts */
+        OTG(c)->GINTSTS = 0xFFFFFFFF;
+        /* unmask global interrupt */
+        _BST(OTG(c)->GAHBCFG, USB_OTG_GAHBCFG_GINT);
+    } else {
+        if (*c->rcc_enr & c->rcc_en) {
+            if (c->clock) c->clock(false);
+            _BST(*c->rcc_rstr, c->rcc_rst);
+            _BCL(*c->rcc_rstr, c->rcc_rst);
+            _BCL(*c->rcc_enr, c->rcc_en);
+        }
+    }
+}
+
+#if defined(OTG_BCD)
+/**\brief Helper. Detects the charging port type
+ * \param c OTG core context
+ * \return \ref usbd_lane_unk, \ref usbd_lane_dsc, \ref usbd_lane_sdp, \ref usbd_lane_cdp
+ * or \ref usbd_lane_dcp
+ */
+static uint8_t bc_detect(struct otg_core *c) {
+    uint8_t res;
+#if defined(USBD_VBUS_DETECT)
+    #define SET_GCCFG(x) OTG(c)->GCCFG = USB_OTG_GCCFG_VBDEN | (x)
+#else
+    #define SET_GCCFG(x) OTG(c)->GCCFG = (x)
+#endif
+    SET_GCCFG(USB_OTG_GCCFG_BCDEN | USB_OTG_GCCFG_DCDEN);
+    if (OTG(c)->GCCFG & USB_OTG_GCCFG_DCDET) {
+        SET_GCCFG(USB_OTG_GCCFG_BCDEN | USB_OTG_GCCFG_PDEN);
+        if (OTG(c)->GCCFG & USB_OTG_GCCFG_PS2DET) {
+            res = usbd_lane_unk;
+        } else if (OTG(c)->GCCFG & USB_OTG_GCCFG_PDET) {
+            SET_GCCFG(USB_OTG_GCCFG_BCDEN | USB_OTG_GCCFG_SDEN);
+            if (OTG(c)->GCCFG & USB_OTG_GCCFG_SDET) {
+                res = usbd_lane_dcp;
+            } else {
+                res = usbd_lane_cdp;
+            }
+        } else {
+            res = usbd_lane_sdp;
+        }
+    } else {
+        res = usbd_lane_dsc;
+    }
+    SET_GCCFG(USB_OTG_GCCFG_PWRDWN);
+    return res;
+}
+#endif
+
+static uint8_t connect(struct otg_core *c, bool connect) {
+#if defined(OTG_GCCFG_LEGACY)
+    if (connect) {
+/* The ST made a strange thing again. Really i dont'understand what is the reason to name
+   signal as PWRDWN (Power down PHY) when it works as "Power up" */
+        _BST(OTG(c)->GCCFG, USB_OTG_GCCFG_PWRDWN);
+        _BCL(OTGD(c)->DCTL, USB_OTG_DCTL_SDIS);
+    } else {
+        _BST(OTGD(c)->DCTL, USB_OTG_DCTL_SDIS);
+        _BCL(OTG(c)->GCCFG, USB_OTG_GCCFG_PWRDWN);
+    }
+    return usbd_lane_unk;
+#else
+#if defined(OTG_BCD)
+    uint8_t res = bc_detect(c);
+#else
+    uint8_t res = usbd_lane_unk;
+#endif
+    if (connect) {
+        _BCL(OTGD(c)->DCTL, USB_OTG_DCTL_SDIS);
+    } else {
+        _BST(OTGD(c)->DCTL, USB_OTG_DCTL_SDIS);
+    }
+    return res;
+#endif
+}
+
+static void setaddr (struct otg_core *c, uint8_t addr) {
+    _BMD(OTGD(c)->DCFG, USB_OTG_DCFG_DAD, addr << 4);
+}
+
+/**\brief Helper. Set up TX fifo
+ * \param c OTG core context
+ * \param ep endpoint index
+ * \param epsize required max packet size in bytes
+ * \return true if TX fifo is successfully set
+ */
+static bool set_tx_fifo(struct otg_core *c, uint8_t ep, uint16_t epsize) {
+    uint32_t _fsa = OTG(c)->DIEPTXF0_HNPTXFSIZ;
+    if (c->fifo_rx) {
+        /* using TX fifo from the plan */
+        if ((ep >= c->max_ep) || ((c->fifo_tx[ep] >> 16) < FIFO_WORDS(epsize))) return false;
+        OTG(c)->DIEPTXF[ep - 1] = c->fifo_tx[ep];
+        return true;
+    }
+    /* calculating initial TX FIFO address. next from EP0 TX fifo */
+    _fsa = 0xFFFF & (_fsa + (_fsa >> 16));
+    /* looking for next free TX fifo address */
+    for (int i = 0; i < (c->max_ep - 1); i++) {
+        uint32_t _t = OTG(c)->DIEPTXF[i];
+        if ((_t & 0xFFFF) < 0x200) {
+            _t = 0xFFFF & (_t + (_t >> 16));
+            if (_t > _fsa) {
+                _fsa = _t;
+            }
+        }
+    }
+    /* calculating requited TX fifo size */
+    /* getting in 32 bit terms */
+    epsize = (epsize + 0x03) >> 2;
+    /* it must be 16 32-bit words minimum */
+    if (epsize < 0x10) epsize = 0x10;
+    /* checking for the available fifo */
+    if ((_fsa + epsize) > c->max_fifo) return false;
+    /* programming fifo register */
+    _fsa |= (epsize << 16);
+    OTG(c)->DIEPTXF[ep - 1] = _fsa;
+    return true;
+}
+
+/**\brief Helper. Moves FIFOs of the enabled core to the new layout.
+ * \details Core must be disconnected. FIFO contents are stale after the move and flushed.
+ */
+static void fifo_reload(struct otg_core *c) {
+    if (getinfo(c) & USBD_HW_ENABLED) {
+        fifo_setup(c);
+        Flush_TX(c, 0x10);
+        Flush_RX(c);
+    }
+}
+
+static bool fifo_plan(struct otg_core *c, struct usbd_fifo_plan *plan) {
+    /* FIFO RAM can't be partitioned under the running transfers */
+    if ((getinfo(c) & USBD_HW_ENABLED) && !(OTGD(c)->DCTL & USB_OTG_DCTL_SDIS)) return false;
+    if (plan == 0) {
+        c->fifo_rx = 0;
+        fifo_reload(c);
+        return true;
+    }
+    /* RX FIFO. Space for SETUP packets, OUT packets with status and transfer complete status */
+    uint32_t _fsa = (plan->rx.packet) ? plan->rx.packet : c->rx_packet;
+    _fsa = ((plan->rx.depth) ? plan->rx.depth : 1) * (FIFO_WORDS(_fsa) + 1);
+    _fsa += (4 * MAX_CONTROL_EP + 6) + (c->max_ep * 2) + 1;
+    plan->rx.start = 0;
+    plan->rx.words = _fsa;
+    plan->ram_words = c->max_fifo;
+    /* TX FIFOs. EP0 TX FIFO is always used */
+    for (int i = 0; i < USBD_FIFO_MAX_TX; i++) {
+        struct usbd_fifo_entry *tx = &plan->tx[i];
+        uint32_t _t = 0;
+        if ((i == 0) || tx->depth) {
+            if (i >= c->max_ep) return false;
+            _t = tx->depth * FIFO_WORDS(tx->packet);
+            /* it must be 16 32-bit words minimum */
+            if (_t < 0x10) _t = 0x10;
+        }
+        tx->start = _fsa;
+        tx->words = _t;
+        _fsa += _t;
+    }
+    if (_fsa > c->max_fifo) return false;
+    /* plan is valid. applying */
+    c->fifo_rx = plan->rx.words;
+    for (int i = 0; i < c->max_ep; i++) {
+        c->fifo_tx[i] = (i < USBD_FIFO_MAX_TX) ? (plan->tx[i].start | (plan->tx[i].words << 16)) : 0;
+    }
+    fifo_reload(c);
+    return true;
+}
+
+static bool ep_config(struct otg_core *c, uint8_t ep, uint8_t eptype, uint16_t epsize) {
+    if (ep == 0) {
+        /* configureing control endpoint EP0 */
+        uint32_t mpsize;
+        if (epsize <= 0x08) {
+            epsize = 0x08;
+            mpsize = 0x03;
+        } else if (epsize <= 0x10) {
+            epsize = 0x10;
+            mpsize = 0x02;
+        } else if (epsize <= 0x20) {
+            epsize = 0x20;
+            mpsize = 0x01;
+        } else {
+            epsize = 0x40;
+            mpsize = 0x00;
+        }
+        /* EP0 TX FIFO size is setted on init level */
+        /* enabling RX and TX interrupts from EP0 */
+        OTGD(c)->DAINTMSK |= 0x00010001;
+        /* setting up EP0 TX and RX registers */
+        /*EPIN(c, ep)->DIEPTSIZ  = epsize;*/
+        EPIN(c, ep)->DIEPCTL = mpsize | USB_OTG_DIEPCTL_SNAK;
+        /* 1 setup packet, 1 packets total */
+        EPOUT(c, ep)->DOEPTSIZ = epsize | (1 << 29) | (1 << 19);
+        EPOUT(c, ep)->DOEPCTL = mpsize | USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_CNAK;
+        return true;
+    }
+    /* high bandwidth endpoint. bits 12:11 are the additional transactions per microframe */
+    uint32_t mult = ((epsize >> 11) & 0x03) + 1;
+    epsize &= 0x7FF;
+    if (ep & 0x80) {
+        ep &= 0x7F;
+        USB_OTG_INEndpointTypeDef* epi = EPIN(c, ep);
+        /* configuring TX endpoint */
+        /* setting up TX fifo and size register */
+        if (mult > 1) {
+            if (!set_tx_fifo(c, ep, epsize * mult)) return false;
+        } else if ((eptype == USB_EPTYPE_ISOCHRONUS) ||
+            (eptype == (USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF))) {
+            if (!set_tx_fifo(c, ep, epsize << 1)) return false;
+        } else {
+            if (!set_tx_fifo(c, ep, epsize)) return false;
+        }
+        /* doublebuffered IN endpoint can preload next packet while current one is in transfer */
+        if (eptype == (USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF)) {
+            c->tx_dblbuf |= (1 << ep);
+        } else {
+            c->tx_dblbuf &= ~(1 << ep);
+        }
+        c->tx_pend[ep] = 0;
+        /* enabling EP TX interrupt */
+        OTGD(c)->DAINTMSK |= (0x0001UL << ep);
+        /* setting up TX control register*/
+        switch (eptype) {
+        case USB_EPTYPE_ISOCHRONUS:
+            epi->DIEPCTL = USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK |
+                           (0x01 << 18) | USB_OTG_DIEPCTL_USBAEP |
+                           USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+                           (ep << 22) | epsize;
+            break;
+        case USB_EPTYPE_BULK:
+        case USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF:
+            epi->DIEPCTL = USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_USBAEP |
+                            (0x02 << 18) | USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+                            (ep << 22) | epsize;
+            break;
+        default:
+            epi->DIEPCTL = USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_USBAEP |
+                            (0x03 << 18) | USB_OTG_DIEPCTL_SD0PID_SEVNFRM |
+                            (ep << 22) | epsize;
+            break;
+        }
+    } else {
+        /* configuring RX endpoint */
+        USB_OTG_OUTEndpointTypeDef* epo = EPOUT(c, ep);
+        /* setting up RX transfer size. one (micro)frame or two packets back-to-back for
+         * doublebuffered endpoint */
+        if (eptype == (USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF)) mult = 2;
+        c->rx_tsize[ep] = _VAL2FLD(USB_OTG_DOEPTSIZ_PKTCNT, mult) | (epsize * mult);
+        epo->DOEPTSIZ = c->rx_tsize[ep];
+        /* setting up RX control register */
+        switch (eptype) {
+        case USB_EPTYPE_ISOCHRONUS:
+            epo->DOEPCTL = USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_CNAK |
+                           USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_USBAEP |
+                           (0x01 << 18) | epsize;
+            break;
+        case USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF:
+        case USB_EPTYPE_BULK:
+            epo->DOEPCTL = USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_CNAK |
+                           USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_USBAEP |
+                           (0x02 << 18) | epsize;
+            break;
+        default:
+            epo->DOEPCTL = USB_OTG_DOEPCTL_SD0PID_SEVNFRM | USB_OTG_DOEPCTL_CNAK |
+                           USB_OTG_DOEPCTL_EPENA | USB_OTG_DOEPCTL_USBAEP |
+                           (0x03 << 18) | epsize;
+            break;
+        }
+    }
+    return true;
+}
+
+static void ep_deconfig(struct otg_core *c, uint8_t ep) {
+    ep &= 0x7F;
+    volatile USB_OTG_INEndpointTypeDef*  epi = EPIN(c, ep);
+    volatile USB_OTG_OUTEndpointTypeDef* epo = EPOUT(c, ep);
+    /* deconfiguring TX part */
+    /* disable interrupt */
+    OTGD(c)->DAINTMSK &= ~(0x10001 << ep);
+    /* decativating endpoint */
+    _BCL(epi->DIEPCTL, USB_OTG_DIEPCTL_USBAEP);
+    /* flushing FIFO */
+    Flush_TX(c, ep);
+    /* disabling endpoint */
+    if ((epi->DIEPCTL & USB_OTG_DIEPCTL_EPENA) && (ep != 0)) {
+        epi->DIEPCTL = USB_OTG_DIEPCTL_EPDIS;
+    }
+    /* clean EP interrupts */
+    epi->DIEPINT = 0xFF;
+    /* deconfiguring TX FIFO */
+    if (ep > 0) {
+        OTG(c)->DIEPTXF[ep-1] = 0x02000200 + 0x200 * ep;
+    }
+    /* deconfigureing RX part */
+    _BCL(epo->DOEPCTL, USB_OTG_DOEPCTL_USBAEP);
+    if ((epo->DOEPCTL & USB_OTG_DOEPCTL_EPENA) && (ep != 0)) {
+        epo->DOEPCTL = USB_OTG_DOEPCTL_EPDIS;
+    }
+    epo->DOEPINT = 0xFF;
+    c->rx_tsize[ep] = 0;
+    c->tx_pend[ep] = 0;
+    c->tx_dblbuf &= ~(1 << ep);
+}
+
+/**\brief Helper. Selects the next (micro)frame for the isochronous endpoint
+ * \return DIEPCTL/DOEPCTL frame parity bits (same positions for IN and OUT)
+ */
+inline static uint32_t iso_next_frame(struct otg_core *c) {
+    return (OTGD(c)->DSTS & (0x01 << USB_OTG_DSTS_FNSOF_Pos)) ? USB_OTG_DIEPCTL_SD0PID_SEVNFRM : USB_OTG_DIEPCTL_SODDFRM;
+}
+
+static int32_t ep_read(struct otg_core *c, uint8_t ep, void* buf, uint16_t blen) {
+    uint32_t len, tmp = 0;
+    volatile uint32_t *fifo = EPFIFO(c, 0);
+    /* no data in RX FIFO */
+    if (!(OTG(c)->GINTSTS & USB_OTG_GINTSTS_RXFLVL)) return -1;
+    ep &= 0x7F;
+    if ((OTG(c)->GRXSTSR & USB_OTG_GRXSTSP_EPNUM) != ep) return -1;
+    /* pop data from fifo */
+    len = _FLD2VAL(USB_OTG_GRXSTSP_BCNT, OTG(c)->GRXSTSP);
+    for (int idx = 0; idx < len; idx++) {
+        if ((idx & 0x03) == 0x00) {
+            tmp = *fifo;
+        }
+        if (idx < blen) {
+            ((uint8_t*)buf)[idx] = tmp & 0xFF;
+            tmp >>= 8;
+        }
+    }
+    /* resuming RX FIFO processing if it was postponed by evt_poll */
+    c->rx_pending = false;
+    if (!(OTG(c)->GINTMSK & USB_OTG_GINTMSK_RXFLVLM)) _BST(OTG(c)->GINTMSK, USB_OTG_GINTMSK_RXFLVLM);
+    /* rearming transfer size for the next (micro)frame */
+    if (c->rx_tsize[ep] && !(EPOUT(c, ep)->DOEPTSIZ & USB_OTG_DOEPTSIZ_PKTCNT)) {
+        EPOUT(c, ep)->DOEPTSIZ = c->rx_tsize[ep];
+    }
+    /* isochronous endpoint receives in the next frame */
+    if ((EPOUT(c, ep)->DOEPCTL & USB_OTG_DOEPCTL_EPTYP) == (0x01 << 18)) {
+        _BST(EPOUT(c, ep)->DOEPCTL, iso_next_frame(c));
+    }
+    _BST(EPOUT(c, ep)->DOEPCTL, USB_OTG_DOEPCTL_CNAK | USB_OTG_DOEPCTL_EPENA);
+    return (len < blen) ? len : blen;
+}
+
+/**\brief Helper. Arms IN endpoint with the preloaded packet
+ * \details Preload is claimed by the atomic exchange, so it's sent once when ep_write() and XFRC
+ * handler both try to arm the endpoint.
+ */
+static void tx_preload(struct otg_core *c, uint8_t ep) {
+    uint16_t _t = __atomic_exchange_n(&c->tx_pend[ep], 0, __ATOMIC_SEQ_CST);
+    if (_t) {
+        EPIN(c, ep)->DIEPTSIZ = _VAL2FLD(USB_OTG_DIEPTSIZ_PKTCNT, 1) | (_t - 1);
+        _BST(EPIN(c, ep)->DIEPCTL, USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK);
+    }
+}
+
+static int32_t ep_peek(struct otg_core *c, uint8_t ep) {
+    uint32_t _t;
+    if (!(OTG(c)->GINTSTS & USB_OTG_GINTSTS_RXFLVL)) return -1;
+    /* reading status without popping it */
+    _t = OTG(c)->GRXSTSR;
+    if ((_t & USB_OTG_GRXSTSP_EPNUM) != (ep & 0x7F)) return -1;
+    return _FLD2VAL(USB_OTG_GRXSTSP_BCNT, _t);
+}
+
+static int32_t ep_write(struct otg_core *c, uint8_t ep, const void *buf, uint16_t blen) {
+    uint32_t len, tmp = 0;
+    bool _pre = false;
+    ep &= 0x7F;
+    volatile uint32_t* fifo = EPFIFO(c, ep);
+    USB_OTG_INEndpointTypeDef* epi = EPIN(c, ep);
+    /* transfer data size in 32-bit words */
+    len = (blen + 3) >> 2;
+    /* no enough space in TX fifo */
+    if (len > _FLD2VAL(USB_OTG_DTXFSTS_INEPTFSAV, epi->DTXFSTS)) return -1;
+    /* check if EP enabled*/
+    if (ep != 0 && epi->DIEPCTL & USB_OTG_DIEPCTL_EPENA) {
+        /* preloading next packet of the doublebuffered endpoint. it will be sent on XFRC.
+         * Preload is published before the data push. Core doesn't send the packet until it's
+         * completely in FIFO, so XFRC handler may arm the endpoint at any moment. */
+        if (!(c->tx_dblbuf & (1 << ep)) || c->tx_pend[ep]) return -1;
+        c->tx_pend[ep] = blen + 1;
+        _pre = true;
+    } else {
+        /* up to 3 packets per microframe for the high bandwidth endpoint */
+        uint32_t pkts = 1;
+        if (ep != 0) {
+            uint32_t mps = _FLD2VAL(USB_OTG_DIEPCTL_MPSIZ, epi->DIEPCTL);
+            if (mps && (blen > mps)) pkts = (blen + mps - 1) / mps;
+        }
+        epi->DIEPTSIZ = _VAL2FLD(USB_OTG_DIEPTSIZ_PKTCNT, pkts) |
+                        _VAL2FLD(USB_OTG_DIEPTSIZ_MULCNT, pkts) | blen;
+        /* isochronous endpoint sends in the next frame */
+        uint32_t _pid = ((epi->DIEPCTL & USB_OTG_DIEPCTL_EPTYP) == (0x01 << 18)) ? iso_next_frame(c) : 0;
+        _BMD(epi->DIEPCTL, USB_OTG_DIEPCTL_STALL, USB_OTG_DIEPCTL_EPENA | USB_OTG_DIEPCTL_CNAK | _pid);
+    }
+    /* push data to FIFO */
+    for (int idx = 0; idx < blen; idx++) {
+        tmp |= (uint32_t)((const uint8_t*)buf)[idx] << ((idx & 0x03) << 3);
+        if ((idx & 0x03) == 0x03 || (idx + 1) == blen) {
+            *fifo = tmp;
+            tmp = 0;
+        }
+    }
+    /* transfer was completed before the preload was published. nobody else will arm it */
+    if (_pre && !(epi->DIEPCTL & USB_OTG_DIEPCTL_EPENA)) tx_preload(c, ep);
+    return blen;
+}
+
+static uint16_t get_frame (struct otg_core *c) {
+    return _FLD2VAL(USB_OTG_DSTS_FNSOF, OTGD(c)->DSTS);
+}
+
+#if defined(OTG_LPM)
+static void lpm_config(struct otg_core *c, bool enable, uint8_t besl) {
+    if (enable) {
+        OTG(c)->GLPMCFG = USB_OTG_GLPMCFG_LPMEN | USB_OTG_GLPMCFG_LPMACK |
+#if defined(USBD_SUSPEND_LOWPOWER)
+                          USB_OTG_GLPMCFG_L1SSEN | USB_OTG_GLPMCFG_L1DSEN |
+#endif
+                          USB_OTG_GLPMCFG_ENBESL | _VAL2FLD(USB_OTG_GLPMCFG_BESLTHRS, besl);
+        _BST(OTG(c)->GINTMSK, USB_OTG_GINTMSK_LPMINTM);
+    } else {
+        _BCL(OTG(c)->GINTMSK, USB_OTG_GINTMSK_LPMINTM);
+        OTG(c)->GLPMCFG = 0;
+    }
+}
+#endif
+
+/* RESUME signaling length. Must be 1-15ms. Fits the window for any loop cost from 2 to 30
+ * cycles per turn when USBD_HCLK is the actual core clock. Lower clock makes it longer.
+ * remote_wakeup() busy-waits for it. */
+#define RWUSIG_LOOPS    (USBD_HCLK / 2000)
+
+static bool remote_wakeup(struct otg_core *c) {
+#if defined(OTG_LPM)
+    if (c->l1_sleep) {
+        /* L1 resume signaling is timed by core. RWUSIG clears automatically.
+         * Host allows it in the LPM token */
+        if (!(OTG(c)->GLPMCFG & USB_OTG_GLPMCFG_REMWAKE)) return false;
+        c->l1_sleep = false;
+        *OTGPCTL(c) &= ~(USB_OTG_PCGCCTL_STOPCLK | USB_OTG_PCGCCTL_GATECLK);
+        _BST(OTGD(c)->DCTL, USB_OTG_DCTL_RWUSIG);
+        return true;
+    }
+#endif
+    *OTGPCTL(c) &= ~(USB_OTG_PCGCCTL_STOPCLK | USB_OTG_PCGCCTL_GATECLK);
+    _BST(OTGD(c)->DCTL, USB_OTG_DCTL_RWUSIG);
+    for (volatile uint32_t i = RWUSIG_LOOPS; i > 0; i--);
+    _BCL(OTGD(c)->DCTL, USB_OTG_DCTL_RWUSIG);
+    return true;
+}
+
+/**\brief Helper. Looks for the isochronous endpoint missed it's frame
+ * \details IN endpoint is disabled and stale data is flushed. OUT endpoint is moved to the
+ * next frame.
+ * \param c OTG core context
+ * \param in true for IN endpoints
+ * \return endpoint address or -1 if there are no more incomplete endpoints
+ */
+static int32_t iso_incomplete(struct otg_core *c, bool in) {
+    uint32_t frame = _FLD2VAL(USB_OTG_DSTS_FNSOF, OTGD(c)->DSTS) & 0x01;
+    for (uint32_t ep = 1; ep < c->max_ep; ep++) {
+        if (in) {
+            USB_OTG_INEndpointTypeDef* epi = EPIN(c, ep);
+            if ((epi->DIEPCTL & (USB_OTG_DIEPCTL_EPTYP | USB_OTG_DIEPCTL_EPENA)) !=
+                ((0x01 << 18) | USB_OTG_DIEPCTL_EPENA)) continue;
+            /* armed for the current frame that is already passed */
+            if (((epi->DIEPCTL >> 16) & 0x01) != frame) continue;
+            _BST(epi->DIEPCTL, USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_EPDIS);
+            _WBS(epi->DIEPINT, USB_OTG_DIEPINT_EPDISD);
+            epi->DIEPINT = USB_OTG_DIEPINT_EPDISD;
+            Flush_TX(c, ep);
+            return ep | 0x80;
+        } else {
+            USB_OTG_OUTEndpointTypeDef* epo = EPOUT(c, ep);
+            if ((epo->DOEPCTL & (USB_OTG_DOEPCTL_EPTYP | USB_OTG_DOEPCTL_EPENA)) !=
+                ((0x01 << 18) | USB_OTG_DOEPCTL_EPENA)) continue;
+            /* armed for the current frame that is already passed */
+            if (((epo->DOEPCTL >> 16) & 0x01) != frame) continue;
+            _BST(epo->DOEPCTL, iso_next_frame(c));
+            return ep;
+        }
+    }
+    return -1;
+}
+
+static void evt_poll(struct otg_core *c, usbd_device *dev, usbd_evt_callback callback) {
+    uint32_t evt;
+    uint32_t ep = 0;
+    while (1) {
+        uint32_t _t = OTG(c)->GINTSTS;
+        /* bus RESET event */
+        if (_t & USB_OTG_GINTSTS_USBRST) {
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_USBRST;
+#if defined(OTG_LPM)
+            c->l1_sleep = false;
+#endif
+#if defined(USBD_SUSPEND_LOWPOWER)
+            *OTGPCTL(c) &= ~USB_OTG_PCGCCTL_STOPCLK;
+#endif
+            for (uint8_t i = 0; i < c->max_ep; i++ ) {
+                ep_deconfig(c, i);
+            }
+            Flush_RX(c);
+            c->rx_pending = false;
+            _BST(OTG(c)->GINTMSK, USB_OTG_GINTMSK_RXFLVLM);
+            continue;
+        } else if (_t & USB_OTG_GINTSTS_ENUMDNE) {
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_ENUMDNE;
+            evt = usbd_evt_reset;
+        } else if (_t & USB_OTG_GINTSTS_IEPINT) {
+            for (;; ep++) {
+                USB_OTG_INEndpointTypeDef* epi = EPIN(c, ep);
+                if (ep >= c->max_ep) return;
+                if (epi->DIEPINT & USB_OTG_DIEPINT_XFRC) {
+                    epi->DIEPINT = USB_OTG_DIEPINT_XFRC;
+                    /* sending preloaded packet */
+                    tx_preload(c, ep);
+                    evt = usbd_evt_eptx;
+                    ep |= 0x80;
+                    break;
+                }
+            }
+        } else if ((_t & USB_OTG_GINTSTS_RXFLVL) && (OTG(c)->GINTMSK & USB_OTG_GINTMSK_RXFLVLM)) {
+            _t = OTG(c)->GRXSTSR;
+            ep = _t & USB_OTG_GRXSTSP_EPNUM;
+            switch (_FLD2VAL(USB_OTG_GRXSTSP_PKTSTS, _t)) {
+            case 0x02:  /* OUT recieved */
+                evt = usbd_evt_eprx;
+                /* EP0 packets are always read by core */
+                c->rx_pending = (ep != 0);
+                break;
+            case 0x06:  /* SETUP recieved */
+                /* flushing TX if something stuck in control endpoint */
+                if (EPIN(c, ep)->DIEPTSIZ & USB_OTG_DIEPTSIZ_PKTCNT) {
+                    Flush_TX(c, ep);
+                }
+                evt = usbd_evt_epsetup;
+                break;
+            default:
+                /* pop GRXSTSP */
+                OTG(c)->GRXSTSP;
+                continue;
+            }
+        } else if (_t & USB_OTG_GINTSTS_IISOIXFR) {
+            int32_t _ep = iso_incomplete(c, true);
+            if (_ep < 0) {
+                OTG(c)->GINTSTS = USB_OTG_GINTSTS_IISOIXFR;
+                continue;
+            }
+            ep = _ep;
+            evt = usbd_evt_isoinc;
+        } else if (_t & USB_OTG_GINTSTS_PXFR_INCOMPISOOUT) {
+            int32_t _ep = iso_incomplete(c, false);
+            if (_ep < 0) {
+                OTG(c)->GINTSTS = USB_OTG_GINTSTS_PXFR_INCOMPISOOUT;
+                continue;
+            }
+            ep = _ep;
+            evt = usbd_evt_isoinc;
+#if !defined(USBD_SOF_DISABLED)
+        } else if (_t & USB_OTG_GINTSTS_SOF) {
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_SOF;
+            evt = usbd_evt_sof;
+#endif
+        } else if (_t & USB_OTG_GINTSTS_USBSUSP) {
+            evt = usbd_evt_susp;
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_USBSUSP;
+#if defined(USBD_SUSPEND_LOWPOWER)
+            *OTGPCTL(c) |= USB_OTG_PCGCCTL_STOPCLK;
+#endif
+        } else if (_t & USB_OTG_GINTSTS_WKUINT) {
+#if defined(USBD_SUSPEND_LOWPOWER)
+            *OTGPCTL(c) &= ~USB_OTG_PCGCCTL_STOPCLK;
+#endif
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_WKUINT;
+#if defined(OTG_LPM)
+            evt = c->l1_sleep ? usbd_evt_l1wkup : usbd_evt_wkup;
+            c->l1_sleep = false;
+        } else if (_t & USB_OTG_GINTSTS_LPMINT) {
+            OTG(c)->GINTSTS = USB_OTG_GINTSTS_LPMINT;
+            evt = usbd_evt_l1susp;
+            c->l1_sleep = true;
+#else
+            evt = usbd_evt_wkup;
+#endif
+        } else {
+            /* no more supported events */
+            return;
+        }
+        callback(dev, evt, ep);
+        /* packet is left in RX FIFO by the callback. postponing RX FIFO processing until ep_read */
+        if (c->rx_pending && (OTG(c)->GINTMSK & USB_OTG_GINTMSK_RXFLVLM)) {
+            _BCL(OTG(c)->GINTMSK, USB_OTG_GINTMSK_RXFLVLM);
+        }
+    }
+}
+
+static uint32_t fnv1a32_turn (uint32_t fnv, uint32_t data ) {
+    for (int i = 0; i < 4 ; i++) {
+        fnv ^= (data & 0xFF);
+        fnv *= 16777619;
+        data >>= 8;
+    }
+    return fnv;
+}
+
+static uint16_t get_serialno_desc(void *buffer) {
+    struct  usb_string_descriptor *dsc = buffer;
+    uint16_t *str = dsc->wString;
+    uint32_t fnv = 2166136261;
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x00));
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x04));
+    fnv = fnv1a32_turn(fnv, *(uint32_t*)(UID_BASE + 0x08));
+    for (int i = 28; i >= 0; i -= 4 ) {
+        uint16_t c = (fnv >> i) & 0x0F;
+        c += (c < 10) ? '0' : ('A' - 10);
+        *str++ = c;
+    }
+    dsc->bDescriptorType = USB_DTYPE_STRING;
+    dsc->bLength = 18;
+    return 18;
+}
+
+#if defined(OTG_LPM)
+#define OTG_LPM_WRAPPER(_name, _core)                                                           \
+static void _name##_lpm_config(bool en, uint8_t besl) { lpm_config(&_core, en, besl); }
+#define OTG_LPM_ENTRY(_name)    _name##_lpm_config
+#else
+#define OTG_LPM_WRAPPER(_name, _core)
+#define OTG_LPM_ENTRY(_name)    0
+#endif
+
+/**\brief Binds OTG core context to the driver call table.
+ * \details Makes a set of the thin wrappers passing the core context to the driver code
+ * and the \ref usbd_driver table for them. Each core gets it's own table, so \ref usbd_device
+ * instances initialized with the different tables are independent and can be polled separately.
+ */
+#define OTG_DRIVER(_name, _core)                                                                \
+static uint32_t _name##_getinfo(void) { return getinfo(&_core); }                               \
+static void _name##_enable(bool en) { enable(&_core, en); }                                     \
+static uint8_t _name##_connect(bool con) { return connect(&_core, con); }                       \
+static void _name##_setaddr(uint8_t addr) { setaddr(&_core, addr); }                            \
+static bool _name##_ep_config(uint8_t ep, uint8_t eptype, uint16_t epsize) {                    \
+    return ep_config(&_core, ep, eptype, epsize);                                               \
+}                                                                                               \
+static void _name##_ep_deconfig(uint8_t ep) { ep_deconfig(&_core, ep); }                        \
+static int32_t _name##_ep_read(uint8_t ep, void *buf, uint16_t blen) {                          \
+    return ep_read(&_core, ep, buf, blen);                                                      \
+}                                                                                               \
+static int32_t _name##_ep_write(uint8_t ep, const void *buf, uint16_t blen) {                   \
+    return ep_write(&_core, ep, buf, blen);                                                     \
+}                                                                                               \
+static void _name##_ep_setstall(uint8_t ep, bool stall) { ep_setstall(&_core, ep, stall); }     \
+static bool _name##_ep_isstalled(uint8_t ep) { return ep_isstalled(&_core, ep); }               \
+static void _name##_evt_poll(usbd_device *dev, usbd_evt_callback callback) {                    \
+    evt_poll(&_core, dev, callback);                                                            \
+}                                                                                               \
+static uint16_t _name##_get_frame(void) { return get_frame(&_core); }                           \
+static bool _name##_remote_wakeup(void) { return remote_wakeup(&_core); }                       \
+static bool _name##_fifo_plan(struct usbd_fifo_plan *plan) { return fifo_plan(&_core, plan); }  \
+static int32_t _name##_ep_peek(uint8_t ep) { return ep_peek(&_core, ep); }                      \
+OTG_LPM_WRAPPER(_name, _core)                                                                   \
+ __attribute__((externally_visible)) const struct usbd_driver _name = {                         \
+    _name##_getinfo,                                                                            \
+    _name##_enable,                                                                             \
+    _name##_connect,                                                                            \
+    _name##_setaddr,                                                                            \
+    _name##_ep_config,                                                                          \
+    _name##_ep_deconfig,                                                                        \
+    _name##_ep_read,                                                                            \
+    _name##_ep_write,                                                                           \
+    _name##_ep_setstall,                                                                        \
+    _name##_ep_isstalled,                                                                       \
+    _name##_evt_poll,                                                                           \
+    _name##_get_frame,                                                                          \
+    get_serialno_desc,                                                                          \
+    _name##_remote_wakeup,                                                                      \
+    OTG_LPM_ENTRY(_name),                                                                       \
+    _name##_fifo_plan,                                                                          \
+    _name##_ep_peek,                                                                            \
+}
+
+#if defined(USBD_STM32F429FS)
+static struct otg_core otgfs = {
+    .base       = USB_OTG_FS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB2ENR,
+    .rcc_rstr   = &RCC->AHB2RSTR,
+    .rcc_en     = RCC_AHB2ENR_OTGFSEN,
+    .rcc_rst    = RCC_AHB2RSTR_OTGFSRST,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .max_fifo   = 320,
+    .rx_fifo    = RX_FIFO_SZ(MAX_RX_PACKET, 4),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 4,
+    .phy        = OTG_PHY_FS,
+};
+
+OTG_DRIVER(usbd_otgfs, otgfs);
+#endif //USBD_STM32F429FS
+
+#if defined(USBD_STM32F429HS)
+static struct otg_core otghs = {
+    .base       = USB_OTG_HS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB1ENR,
+    .rcc_rstr   = &RCC->AHB1RSTR,
+    .rcc_en     = RCC_AHB1ENR_OTGHSEN,
+    .rcc_rst    = RCC_AHB1RSTR_OTGHRST,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL |
+                  _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x09) | _VAL2FLD(USB_OTG_GUSBCFG_TOCAL, 0x01),
+    .max_fifo   = 1024,
+    .rx_fifo    = 10 + (2 * (MAX_RX_PACKET / 4) + 1),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 6,
+    .phy        = OTG_PHY_HSFS,
+};
+
+OTG_DRIVER(usbd_otghs, otghs);
+#endif //USBD_STM32F429HS
+
+#if defined(USBD_STM32F105)
+static struct otg_core otgfs = {
+    .base       = USB_OTG_FS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHBENR,
+    .rcc_rstr   = &RCC->AHBRSTR,
+    .rcc_en     = RCC_AHBENR_OTGFSEN,
+    .rcc_rst    = RCC_AHBRSTR_OTGFSRST,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .max_fifo   = 320,
+    .rx_fifo    = RX_FIFO_SZ(MAX_RX_PACKET, 4),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 4,
+    .phy        = OTG_PHY_FS,
+};
+
+OTG_DRIVER(usbd_otgfs, otgfs);
+#endif //USBD_STM32F105
+
+#if defined(USBD_STM32F446FS)
+static struct otg_core otgfs = {
+    .base       = USB_OTG_FS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB2ENR,
+    .rcc_rstr   = &RCC->AHB2RSTR,
+    .rcc_en     = RCC_AHB2ENR_OTGFSEN,
+    .rcc_rst    = RCC_AHB2RSTR_OTGFSRST,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .max_fifo   = 320,
+    .rx_fifo    = RX_FIFO_SZ(MAX_RX_PACKET, 6),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 6,
+    .phy        = OTG_PHY_FS,
+};
+
+OTG_DRIVER(usbd_otgfs, otgfs);
+#endif //USBD_STM32F446FS
+
+#if defined(USBD_STM32F446HS)
+#if defined(USBD_USE_EXT_ULPI)
+#define OTGHS_RX_PACKET 512
+#else
+#define OTGHS_RX_PACKET MAX_RX_PACKET
+#endif
+
+static void otghs_clock(bool enable) {
+#if defined(USBD_USE_EXT_ULPI)
+    /* ULPI clock keeps running in sleep mode */
+    if (enable) _BST(RCC->AHB1LPENR, RCC_AHB1LPENR_OTGHSLPEN | RCC_AHB1LPENR_OTGHSULPILPEN);
+#else
+    /* ULPI clock must be gated in sleep mode when the internal PHY is used */
+    if (enable) _BCL(RCC->AHB1LPENR, RCC_AHB1LPENR_OTGHSULPILPEN);
+#endif
+}
+
+static struct otg_core otghs = {
+    .base       = USB_OTG_HS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB1ENR,
+    .rcc_rstr   = &RCC->AHB1RSTR,
+#if defined(USBD_USE_EXT_ULPI)
+    .rcc_en     = RCC_AHB1ENR_OTGHSEN | RCC_AHB1ENR_OTGHSULPIEN,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x09),
+    .phy        = OTG_PHY_ULPI,
+#else
+    .rcc_en     = RCC_AHB1ENR_OTGHSEN,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .phy        = OTG_PHY_HSFS,
+#endif
+    .rcc_rst    = RCC_AHB1RSTR_OTGHRST,
+    .clock      = otghs_clock,
+    .max_fifo   = 1024,
+    .rx_fifo    = RX_FIFO_SZ(OTGHS_RX_PACKET, 9),
+    .rx_packet  = OTGHS_RX_PACKET,
+    .max_ep     = 9,
+};
+
+OTG_DRIVER(usbd_otghs, otghs);
+#endif //USBD_STM32F446HS
+
+#if defined(USBD_STM32L476)
+static void otgfs_clock(bool enable) {
+    /* Vbus supply for USB */
+    if (enable) {
+        _BST(PWR->CR2, PWR_CR2_USV);
+    } else {
+        _BCL(PWR->CR2, PWR_CR2_USV);
+    }
+}
+
+static struct otg_core otgfs = {
+    .base       = USB_OTG_FS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB2ENR,
+    .rcc_rstr   = &RCC->AHB2RSTR,
+    .rcc_en     = RCC_AHB2ENR_OTGFSEN,
+    .rcc_rst    = RCC_AHB2RSTR_OTGFSRST,
+    .clock      = otgfs_clock,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .max_fifo   = 320,
+    .rx_fifo    = RX_FIFO_SZ(MAX_RX_PACKET, 6),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 6,
+    .phy        = OTG_PHY_FS,
+};
+
+OTG_DRIVER(usbd_otgfs, otgfs);
+#endif //USBD_STM32L476
+
+#if defined(USBD_STM32H743FS)
+static struct otg_core otgfs = {
+    .base       = USB_OTG_FS_PERIPH_BASE,
+    .rcc_enr    = &RCC->AHB1ENR,
+    .rcc_rstr   = &RCC->AHB1RSTR,
+    .rcc_en     = RCC_AHB1ENR_USB2OTGFSEN,
+    .rcc_rst    = RCC_AHB1RSTR_USB2OTGFSRST,
+    .gusbcfg    = USB_OTG_GUSBCFG_FDMOD | USB_OTG_GUSBCFG_PHYSEL | _VAL2FLD(USB_OTG_GUSBCFG_TRDT, 0x06),
+    .max_fifo   = 320,
+    .rx_fifo    = RX_FIFO_SZ(MAX_RX_PACKET, 6),
+    .rx_packet  = MAX_RX_PACKET,
+    .max_ep     = 6,
+    .phy        = OTG_PHY_FS,
+};
+
+OTG_DRIVER(usbd_otgfs, otgfs);
+#endif //USBD_STM32H743FS
+
+#endif //USBD_STM32F429FS || USBD_STM32F429HS || USBD_STM32F105 || USBD_STM32F446FS || USBD_STM32F446HS || USBD_STM32L476 || USBD_STM32H743FS
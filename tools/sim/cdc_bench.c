@@ -0,0 +1,132 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Enumeration time and CDC loopback data rates of the demo/cdc_loop.c on the register model.
+ * The demo is included as is, it's main() is renamed and never called. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim_host.h"
+#include "sim_model.h"
+
+#define main cdc_loop_main
+#include "cdc_loop.c"
+#undef main
+
+#if !defined(BENCH_SIZE)
+#define BENCH_SIZE      0x10000     /* loopback data amount */
+#endif
+#define BENCH_CHUNK     (sizeof(fifo) - CDC_DATA_SZ)
+#if !defined(BENCH_POLL_NS)
+#define BENCH_POLL_NS   SIM_HOST_POLL_MEASURE   /* or fixed device time of usbd_poll in ns */
+#endif
+#if defined(USBD_USE_EXT_ULPI)
+#define BENCH_HS        true        /* ULPI PHY runs at high speed */
+#else
+#define BENCH_HS        false
+#endif
+
+static struct sim_host host;
+static uint8_t txd[BENCH_CHUNK];
+static uint8_t rxd[BENCH_CHUNK];
+
+static void print_stats(const char *name, const struct sim_host_stats *s, uint64_t time) {
+    if (s->xfers == 0) return;
+    printf("  %-10s %6u xfers %8llu bytes %9.1f kB/s  latency us min %.1f avg %.1f max %.1f"
+           "  naks %u errors %u\n", name, (unsigned)s->xfers, (unsigned long long)s->bytes,
+           time ? s->bytes * 1e6 / time : 0.0, s->lat_min / 1e3,
+           s->lat_sum / 1e3 / s->xfers, s->lat_max / 1e3, (unsigned)s->naks,
+           (unsigned)s->errors);
+}
+
+/* device time of usbd_poll, it's the only difference between the drivers at the same bus speed */
+static void print_poll(uint64_t time, uint32_t polls, uint32_t accesses) {
+    if (polls == 0) return;
+    printf("  usbd_poll avg %.3f us", time / 1e3 / polls);
+#if defined(SIM_MODEL_OTG)
+    printf(", %.1f register accesses trapped by the model", (double)accesses / polls);
+#else
+    (void)accesses;
+#endif
+    printf("\n");
+}
+
+int main(void) {
+    uint64_t start, poll_time;
+    uint32_t pos, polls, accesses = 0;
+    int res;
+
+    if (!SIM_MODEL_INIT()) {
+        fprintf(stderr, "%s: model init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    cdc_init_usbd();
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    sim_host_init(&host, &SIM_MODEL_PORT, &udev, BENCH_HS);
+    host.poll_ns = BENCH_POLL_NS;
+
+    res = sim_host_enumerate(&host, 1);
+    if (res < 0) {
+        fprintf(stderr, "%s: enumeration failed (%d)\n", SIM_MODEL_NAME, res);
+        return 1;
+    }
+    if (host.poll_ns == SIM_HOST_POLL_MEASURE) {
+        printf("cdc_loop %s %s, measured usbd_poll time\n", SIM_MODEL_NAME, BENCH_HS ? "HS" : "FS");
+    } else {
+        printf("cdc_loop %s %s, usbd_poll %u ns\n", SIM_MODEL_NAME, BENCH_HS ? "HS" : "FS",
+               (unsigned)host.poll_ns);
+    }
+    printf("  enumeration %.3f ms, %u control transfers, %u polls\n", host.enum_time / 1e6,
+           (unsigned)host.stats[0][0].xfers, (unsigned)host.polls);
+
+    /* demo starts data IN endpoint by ZLP */
+    res = sim_host_read(&host, CDC_TXD_EP, rxd, BENCH_CHUNK);
+    if (res != 0) {
+        fprintf(stderr, "%s: ZLP expected (%d)\n", SIM_MODEL_NAME, res);
+        return 1;
+    }
+    sim_host_clear_stats(&host);
+    start = host.now;
+    polls = host.polls;
+    poll_time = host.poll_time;
+#if defined(SIM_MODEL_OTG)
+    accesses = otg_model_stats()->accesses;
+#endif
+    for (pos = 0; pos < BENCH_SIZE; pos += BENCH_CHUNK) {
+        for (size_t i = 0; i < BENCH_CHUNK; i++) {
+            txd[i] = (uint8_t)(pos + i * 7);
+        }
+        res = sim_host_write(&host, CDC_RXD_EP, txd, BENCH_CHUNK, false);
+        if (res != (int)BENCH_CHUNK) {
+            fprintf(stderr, "%s: loopback OUT failed (%d)\n", SIM_MODEL_NAME, res);
+            return 1;
+        }
+        res = sim_host_read(&host, CDC_TXD_EP, rxd, BENCH_CHUNK);
+        if (res != (int)BENCH_CHUNK || memcmp(txd, rxd, BENCH_CHUNK)) {
+            fprintf(stderr, "%s: loopback IN failed (%d)\n", SIM_MODEL_NAME, res);
+            return 1;
+        }
+    }
+    printf("  loopback %u bytes in %.3f ms, %u polls\n", (unsigned)pos, (host.now - start) / 1e6,
+           (unsigned)(host.polls - polls));
+    print_stats("bulk out", &host.stats[0][CDC_RXD_EP & 0x0F], host.now - start);
+    print_stats("bulk in", &host.stats[1][CDC_TXD_EP & 0x0F], host.now - start);
+#if defined(SIM_MODEL_OTG)
+    accesses = otg_model_stats()->accesses - accesses;
+#endif
+    print_poll(host.poll_time - poll_time, host.polls - polls, accesses);
+    return 0;
+}
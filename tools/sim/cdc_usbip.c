@@ -0,0 +1,50 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Exports the demo/cdc_loop.c running on the register model over USB/IP.
+ * The demo is included as is, it's main() is renamed and never called. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "sim_host.h"
+#include "sim_model.h"
+#include "usbip_server.h"
+
+#define main cdc_loop_main
+#include "cdc_loop.c"
+#undef main
+
+static struct sim_host host;
+
+int main(int argc, char **argv) {
+    uint16_t port = (argc > 1) ? atoi(argv[1]) : USBIP_PORT;
+    int res;
+
+    if (!SIM_MODEL_INIT()) {
+        fprintf(stderr, "%s: model init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    cdc_init_usbd();
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    sim_host_init(&host, &SIM_MODEL_PORT, &udev, false);
+    printf("cdc_loop %s exported on 127.0.0.1:%u, bus id %s\n", SIM_MODEL_NAME,
+           (unsigned)port, USBIP_BUSID);
+    fflush(stdout);
+    res = usbip_server_run(&host, port);
+    fprintf(stderr, "usbip: %s\n", strerror(-res));
+    return 1;
+}
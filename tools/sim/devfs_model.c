@@ -0,0 +1,323 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "stm32.h"
+#include "usb.h"
+#include "devfs_model.h"
+
+/* Must match the driver traits */
+#if defined(USBD_STM32L100) || (defined(USBD_STM32F103) && \
+    !defined(STM32F302x8) && !defined(STM32F302xE) && !defined(STM32F303xE))
+    #define PMA_STEP        2
+#else
+    #define PMA_STEP        1
+#endif
+
+#if defined(USBD_STM32L433) || defined(USBD_STM32WB55)
+    #define USB_CLOCKED()   ((RCC->APB1ENR1 & RCC_APB1ENR1_USBFSEN) && \
+                            !(RCC->APB1RSTR1 & RCC_APB1RSTR1_USBFSRST))
+#else
+    #define USB_CLOCKED()   ((RCC->APB1ENR & RCC_APB1ENR_USBEN) && \
+                            !(RCC->APB1RSTR & RCC_APB1RSTR_USBRST))
+#endif
+
+/* EPnR bits by the access type */
+#define EPR_RW          (USB_EP_T_FIELD | USB_EP_KIND | USB_EPADDR_FIELD)
+#define EPR_RC_W0       (USB_EP_CTR_RX | USB_EP_CTR_TX)
+#define EPR_T           (USB_EP_DTOG_RX | USB_EPRX_STAT | USB_EP_DTOG_TX | USB_EPTX_STAT)
+
+#define SWBUF_TX        USB_EP_DTOG_RX
+#define SWBUF_RX        USB_EP_DTOG_TX
+
+/* buffer descriptor words */
+#define BT_ADDR_TX      0
+#define BT_COUNT_TX     1
+#define BT_ADDR_RX      2
+#define BT_COUNT_RX     3
+
+static uint8_t missed_sof;
+
+inline static volatile uint16_t *epr(int i) {
+    return &sim_usb.EP0R + 2 * i;
+}
+
+/** \brief Returns pointer to the PMA halfword by the PMA offset */
+inline static uint16_t *pma16(uint16_t off) {
+    return &sim_pma[(off >> 1) * PMA_STEP];
+}
+
+/** \brief Returns pointer to the buffer descriptor word */
+inline static uint16_t *btable(int i, int word) {
+    return pma16((sim_usb.BTABLE & ~0x07) + i * 8 + word * 2);
+}
+
+static bool powered(void) {
+    return USB_CLOCKED() && !(sim_usb.CNTR & (USB_CNTR_PDWN | USB_CNTR_FRES));
+}
+
+/** \brief Updates ISTR CTR, DIR and EP_ID. Lower endpoint has a higher priority */
+static void update_istr(void) {
+    uint16_t istr = sim_usb.ISTR & ~(USB_ISTR_CTR | USB_ISTR_DIR | USB_ISTR_EP_ID);
+    for (int i = 0; i < 8; i++) {
+        uint16_t r = *epr(i);
+        if (r & (USB_EP_CTR_RX | USB_EP_CTR_TX)) {
+            istr |= USB_ISTR_CTR | i;
+            if (r & USB_EP_CTR_RX) istr |= USB_ISTR_DIR;
+            break;
+        }
+    }
+    sim_usb.ISTR = istr;
+}
+
+void devfs_model_epr_write(volatile uint16_t *reg, uint16_t val) {
+    uint16_t old = *reg;
+    *reg = (val & EPR_RW) | (old & val & EPR_RC_W0) | ((old ^ val) & EPR_T) | (old & USB_EP_SETUP);
+    update_istr();
+}
+
+/** \brief Returns endpoint register index addressed by token or -1 */
+static int find_ep(uint8_t addr, uint8_t ep) {
+    if (!powered()) return -1;
+    if (!(sim_usb.DADDR & USB_DADDR_EF) || ((sim_usb.DADDR & USB_DADDR_ADD) != addr)) return -1;
+    for (int i = 0; i < 8; i++) {
+        if ((*epr(i) & USB_EPADDR_FIELD) == (ep & 0x0F)) return i;
+    }
+    return -1;
+}
+
+/** \brief Stores received packet to the buffer pointed by ADDR/COUNT pair */
+static int rx_packet(int i, int word, const uint8_t *buf, uint16_t len) {
+    uint16_t *cnt = btable(i, word + 1);
+    uint16_t nblk = (*cnt >> 10) & 0x1F;
+    uint16_t bsize = (*cnt & 0x8000) ? (nblk + 1) * 32 : nblk * 2;
+    uint16_t addr = *btable(i, word);
+    /* buffer overrun. Excess data is not written, STALL instead of ACK, no CTR */
+    if (len > bsize) return SIM_STALL;
+    for (uint16_t n = 0; n < len; n += 2) {
+        uint16_t _t = buf[n];
+        if (n + 1 < len) _t |= buf[n + 1] << 8;
+        *pma16(addr + n) = _t;
+    }
+    *cnt = (*cnt & ~0x03FF) | len;
+    return SIM_ACK;
+}
+
+/** \brief Loads packet to transmit from the buffer pointed by ADDR/COUNT pair */
+static int tx_packet(int i, int word, uint8_t *buf, uint16_t blen) {
+    uint16_t addr = *btable(i, word);
+    uint16_t len = *btable(i, word + 1) & 0x03FF;
+    for (uint16_t n = 0; (n < len) && (n < blen); n++) {
+        uint16_t _t = *pma16(addr + (n & ~0x01));
+        buf[n] = (n & 0x01) ? (_t >> 8) : (_t & 0xFF);
+    }
+    return len;
+}
+
+void devfs_model_init(void) {
+    memset((void*)&sim_rcc, 0, sizeof(sim_rcc));
+    memset((void*)&sim_syscfg, 0, sizeof(sim_syscfg));
+    memset((void*)&sim_usb, 0, sizeof(sim_usb));
+    memset(sim_pma, 0, sizeof(sim_pma));
+    sim_usb.CNTR = USB_CNTR_PDWN | USB_CNTR_FRES;
+    missed_sof = 0;
+}
+
+bool devfs_model_irq(void) {
+    return (sim_usb.ISTR & sim_usb.CNTR & 0xFF80) != 0;
+}
+
+bool devfs_model_attached(void) {
+    if (!powered()) return false;
+#if defined(USBD_STM32L052) || defined(USBD_STM32L433) || defined(USBD_STM32WB55)
+    return (sim_usb.BCDR & USB_BCDR_DPPU) != 0;
+#elif defined(USBD_STM32L100)
+    return (sim_syscfg.PMC & SYSCFG_PMC_USB_PU) != 0;
+#else
+    return true;
+#endif
+}
+
+void devfs_model_reset(void) {
+    for (int i = 0; i < 8; i++) {
+        *epr(i) = 0;
+    }
+    sim_usb.DADDR = 0;
+    sim_usb.ISTR = (sim_usb.ISTR & ~(USB_ISTR_CTR | USB_ISTR_DIR | USB_ISTR_EP_ID)) | USB_ISTR_RESET;
+    missed_sof = 0;
+}
+
+void devfs_model_frame(bool sof) {
+    if (!powered()) return;
+    if (sof) {
+        missed_sof = 0;
+        sim_usb.FNR = (sim_usb.FNR & ~USB_FNR_FN) | ((sim_usb.FNR + 1) & USB_FNR_FN);
+        sim_usb.ISTR |= USB_ISTR_SOF;
+    } else {
+        sim_usb.ISTR |= USB_ISTR_ESOF;
+        if (++missed_sof == 3) sim_usb.ISTR |= USB_ISTR_SUSP;
+    }
+}
+
+void devfs_model_resume(void) {
+    missed_sof = 0;
+    sim_usb.ISTR |= USB_ISTR_WKUP;
+}
+
+bool devfs_model_rwakeup(void) {
+    bool res = (sim_usb.CNTR & (USB_CNTR_RESUME | USB_CNTR_L1RESUME)) != 0;
+    /* L1 resume signaling is timed by hardware */
+    sim_usb.CNTR &= ~USB_CNTR_L1RESUME;
+    return res;
+}
+
+int devfs_model_setup(uint8_t addr, uint8_t ep, const void *pkt) {
+    int i = find_ep(addr, ep);
+    if (i < 0) return SIM_NORESP;
+    volatile uint16_t *reg = epr(i);
+    uint16_t r = *reg;
+    if (((r & USB_EP_T_FIELD) != USB_EP_CONTROL) || ((r & USB_EPRX_STAT) == USB_EP_RX_DIS)) {
+        return SIM_NORESP;
+    }
+    /* SETUP is accepted regardless of the STAT_RX */
+    int res = rx_packet(i, BT_ADDR_RX, pkt, 8);
+    if (res != SIM_ACK) return res;
+    /* both directions are NAKed, data stage starts with DATA1 */
+    r &= ~(USB_EPRX_STAT | USB_EPTX_STAT);
+    *reg = r | USB_EP_RX_NAK | USB_EP_TX_NAK | USB_EP_DTOG_RX | USB_EP_DTOG_TX |
+           USB_EP_SETUP | USB_EP_CTR_RX;
+    update_istr();
+    return SIM_ACK;
+}
+
+int devfs_model_out(uint8_t addr, uint8_t ep, bool data1, const void *buf, uint16_t len) {
+    int i = find_ep(addr, ep);
+    if (i < 0) return SIM_NORESP;
+    volatile uint16_t *reg = epr(i);
+    uint16_t r = *reg;
+    bool iso = (r & USB_EP_T_FIELD) == USB_EP_ISOCHRONOUS;
+    int res;
+    switch (r & USB_EPRX_STAT) {
+    case USB_EP_RX_DIS:
+        return SIM_NORESP;
+    case USB_EP_RX_STALL:
+        return iso ? SIM_NORESP : SIM_STALL;
+    case USB_EP_RX_NAK:
+        return iso ? SIM_NORESP : SIM_NAK;
+    default:
+        break;
+    }
+    switch (r & (USB_EP_T_FIELD | USB_EP_KIND)) {
+    case USB_EP_ISOCHRONOUS:
+    case USB_EP_ISOCHRONOUS | USB_EP_KIND:
+        /* no handshake, no data toggle. DTOG_RX points to the buffer used by USB */
+        if (rx_packet(i, (r & USB_EP_DTOG_RX) ? BT_ADDR_RX : BT_ADDR_TX, buf, len) != SIM_ACK) {
+            return SIM_NORESP;
+        }
+        r ^= USB_EP_DTOG_RX;
+        break;
+    case USB_EP_BULK | USB_EP_KIND:
+        /* buffer is owned by the application */
+        if (!(r & USB_EP_DTOG_RX) == !(r & SWBUF_RX)) return SIM_NAK;
+        /* data toggle mismatch. Packet is ACKed and dropped */
+        if (data1 != !!(r & USB_EP_DTOG_RX)) return SIM_ACK;
+        res = rx_packet(i, (r & USB_EP_DTOG_RX) ? BT_ADDR_RX : BT_ADDR_TX, buf, len);
+        if (res != SIM_ACK) return res;
+        r ^= USB_EP_DTOG_RX;
+        break;
+    default:
+        /* control endpoint with STATUS_OUT accepts only zero length OUT */
+        if (((r & (USB_EP_T_FIELD | USB_EP_KIND)) == (USB_EP_CONTROL | USB_EP_KIND)) && len) {
+            return SIM_STALL;
+        }
+        if (data1 != !!(r & USB_EP_DTOG_RX)) return SIM_ACK;
+        res = rx_packet(i, BT_ADDR_RX, buf, len);
+        if (res != SIM_ACK) return res;
+        r = ((r ^ USB_EP_DTOG_RX) & ~USB_EPRX_STAT) | USB_EP_RX_NAK;
+        break;
+    }
+    *reg = (r & ~USB_EP_SETUP) | USB_EP_CTR_RX;
+    update_istr();
+    return SIM_ACK;
+}
+
+int devfs_model_in(uint8_t addr, uint8_t ep, bool *data1, void *buf, uint16_t blen) {
+    int i = find_ep(addr, ep);
+    if (i < 0) return SIM_NORESP;
+    volatile uint16_t *reg = epr(i);
+    uint16_t r = *reg;
+    bool iso = (r & USB_EP_T_FIELD) == USB_EP_ISOCHRONOUS;
+    int len;
+    switch (r & USB_EPTX_STAT) {
+    case USB_EP_TX_DIS:
+        return SIM_NORESP;
+    case USB_EP_TX_STALL:
+        return iso ? SIM_NORESP : SIM_STALL;
+    case USB_EP_TX_NAK:
+        return iso ? SIM_NORESP : SIM_NAK;
+    default:
+        break;
+    }
+    *data1 = !!(r & USB_EP_DTOG_TX);
+    switch (r & (USB_EP_T_FIELD | USB_EP_KIND)) {
+    case USB_EP_ISOCHRONOUS:
+    case USB_EP_ISOCHRONOUS | USB_EP_KIND:
+        /* DATA0 only. DTOG_TX points to the buffer used by USB */
+        *data1 = false;
+        len = tx_packet(i, (r & USB_EP_DTOG_TX) ? BT_ADDR_RX : BT_ADDR_TX, buf, blen);
+        r ^= USB_EP_DTOG_TX;
+        break;
+    case USB_EP_BULK | USB_EP_KIND:
+        /* buffer is owned by the application */
+        if (!(r & USB_EP_DTOG_TX) == !(r & SWBUF_TX)) return SIM_NAK;
+        len = tx_packet(i, (r & USB_EP_DTOG_TX) ? BT_ADDR_RX : BT_ADDR_TX, buf, blen);
+        r ^= USB_EP_DTOG_TX;
+        break;
+    default:
+        len = tx_packet(i, BT_ADDR_TX, buf, blen);
+        r = ((r ^ USB_EP_DTOG_TX) & ~USB_EPTX_STAT) | USB_EP_TX_NAK;
+        break;
+    }
+    *reg = r | USB_EP_CTR_TX;
+    update_istr();
+    return len;
+}
+
+int devfs_model_lpm(uint8_t addr, uint16_t attr) {
+    if (!powered() || !(sim_usb.DADDR & USB_DADDR_EF) ||
+        ((sim_usb.DADDR & USB_DADDR_ADD) != addr)) return SIM_NORESP;
+    if (!(sim_usb.LPMCSR & USB_LPMCSR_LMPEN)) return SIM_STALL;
+    if (!(sim_usb.LPMCSR & USB_LPMCSR_LPMACK)) return SIM_NYET;
+    sim_usb.LPMCSR = (sim_usb.LPMCSR & ~(USB_LPMCSR_BESL | USB_LPMCSR_REMWAKE)) |
+                     (attr & USB_LPMCSR_BESL) | ((attr & 0x100) ? USB_LPMCSR_REMWAKE : 0);
+    sim_usb.ISTR |= USB_ISTR_L1REQ;
+    return SIM_ACK;
+}
+
+const struct sim_port devfs_model_port = {
+    .irq        = devfs_model_irq,
+    .attached   = devfs_model_attached,
+    .reset      = devfs_model_reset,
+    .frame      = devfs_model_frame,
+    .eopf       = 0,
+    .resume     = devfs_model_resume,
+    .rwakeup    = devfs_model_rwakeup,
+    .setup      = devfs_model_setup,
+    .out        = devfs_model_out,
+    .in         = devfs_model_in,
+    .lpm        = devfs_model_lpm,
+};
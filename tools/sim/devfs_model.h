@@ -0,0 +1,111 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _DEVFS_MODEL_H_
+#define _DEVFS_MODEL_H_
+#if defined(__cplusplus)
+    extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim.h"
+
+/**\addtogroup SIM_DEVFS USB FS device register model
+ * \brief Host-side model of the STM32 USB FS device peripheral.
+ * \details Runs the unchanged \ref usbd_devfs driver on the host. The model keeps EPnR, ISTR,
+ * BTABLE and PMA in the host memory declared by the tools/sim/stm32.h and applies toggle (t)
+ * and rc_w0 semantics of the EPnR bits on each driver write. PMA layout (1x16 or 2x16) follows
+ * the family macros. Bus side is driven by the token functions below, each of them completes
+ * one transaction and returns the device handshake, see \ref SIM. Build example:
+ * \code
+ * cc -Itools/sim -Iinc -DSTM32L0 -DSTM32L052xx src/usbd_core.c src/usbd_stm32_devfs.c \
+ *    tools/sim/stm32.c tools/sim/devfs_model.c app.c
+ * \endcode
+ * @{ */
+
+/**\brief Resets the peripheral and PMA to the power-on state */
+void devfs_model_init(void);
+
+/**\brief Checks pending interrupts
+ * \return TRUE if ISTR has unmasked interrupt flags. Call \ref usbd_poll while it's TRUE.
+ */
+bool devfs_model_irq(void);
+
+/**\brief Checks device attachment
+ * \return TRUE if the peripheral is clocked and the DP pull-up is enabled
+ */
+bool devfs_model_attached(void);
+
+/**\brief Signals USB bus reset */
+void devfs_model_reset(void);
+
+/**\brief Passes one 1ms frame
+ * \param sof TRUE if the host sends SOF. 3 frames without SOF signal SUSPEND.
+ */
+void devfs_model_frame(bool sof);
+
+/**\brief Signals host-initiated resume */
+void devfs_model_resume(void);
+
+/**\brief Checks device-initiated resume signaling
+ * \return TRUE if the CNTR_RESUME or CNTR_L1RESUME is set by the driver
+ */
+bool devfs_model_rwakeup(void);
+
+/**\brief SETUP transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param pkt 8 bytes of the setup packet
+ * \return transaction result
+ */
+int devfs_model_setup(uint8_t addr, uint8_t ep, const void *pkt);
+
+/**\brief OUT transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param data1 TRUE for the DATA1 PID
+ * \param buf pointer to the packet data
+ * \param len packet length
+ * \return transaction result
+ */
+int devfs_model_out(uint8_t addr, uint8_t ep, bool data1, const void *buf, uint16_t len);
+
+/**\brief IN transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param[out] data1 set to TRUE for the DATA1 PID
+ * \param buf pointer to the buffer for the packet data
+ * \param blen buffer size
+ * \return packet length or negative transaction result
+ */
+int devfs_model_in(uint8_t addr, uint8_t ep, bool *data1, void *buf, uint16_t blen);
+
+/**\brief LPM extended token
+ * \param addr device address
+ * \param attr bmAttributes of the LPM token. BESL in bits 7:4, bRemoteWake in bit 8.
+ * \return \ref SIM_ACK, \ref SIM_NYET or \ref SIM_STALL if LPM is not enabled
+ */
+int devfs_model_lpm(uint8_t addr, uint16_t attr);
+
+/**\brief Bus side functions of the model for the \ref SIM_HOST */
+extern const struct sim_port devfs_model_port;
+
+/** @} */
+
+#if defined(__cplusplus)
+    }
+#endif
+#endif //_DEVFS_MODEL_H_
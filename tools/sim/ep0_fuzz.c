@@ -0,0 +1,546 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Control endpoint fuzzer. Input bytes are the script of the EP0 tokens sent to the register
+ * model. The device stack runs the real driver and usbd_core.c, the state of the control
+ * transfer is checked after each token and the program aborts on the first violation.
+ *
+ * Input format:
+ *   byte 0      EP0 size (bits 7:6) and control buffer payload size (2 + bits 5:0 * 4)
+ *   op 0xX0     SETUP, followed by 8 bytes of the request
+ *   op 0xX1     OUT DATA0/1 (bit 3), followed by the length byte and the payload
+ *   op 0xX2     IN with the buffer length (bits 7:4) * 8
+ *   op 0xX3     bus reset
+ *   op 0xX4     frame with SOF (bit 3)
+ *   op 0xX5     completes deferred request with (bits 7:4) * 8 bytes, stalls it if bit 3 is set
+ *   op 0xX6     switches to address 0 or to the last requested one (bit 3). With bit 4 set is
+ *               followed by 8 bytes of the SETUP that preempts the next deferred control
+ *               callback (USBD_SPLIT_ISR only)
+ *   op 0xX7     vendor request (bits 7:4), followed by wValue and wLength bytes
+ *
+ * Vendor requests of the test application (wValue is the DATA-IN length):
+ *   0x01        device to host from the static pattern
+ *   0x02        device to host in the streaming mode
+ *   0x03        device to host from req->data
+ *   0x04        host to device to req->data or in the streaming mode if it doesn't fit
+ *   0x05        deferred by usbd_nak in any direction
+ *
+ * Build with libFuzzer (EP0_FUZZ_LIBFUZZER defined) or standalone. Standalone program runs
+ * the files given in the command line, stdin if there are no arguments (AFL) or the number of
+ * pseudo-random inputs with "-r count [seed]".
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "usb.h"
+#include "sim_model.h"
+
+#define _MIN(a, b) ((a) < (b)) ? (a) : (b)
+
+#define FUZZ_PATTERN    0x180       /* static DATA-IN source size */
+#define FUZZ_CANARY     0x20        /* guard bytes after the control buffer */
+#define FUZZ_POLL_MAX   0x100       /* usbd_poll limit for one interrupt service */
+#define FUZZ_INPUT_MAX  0x1000      /* input size limit for the standalone runs */
+
+#define FUZZ_CHECK(cond) \
+    do { if (!(cond)) fuzz_fail(#cond, __LINE__); } while (0)
+
+static const struct sim_port *const port = &SIM_MODEL_PORT;
+static usbd_device udev;
+static uint32_t *ubuf;
+static uint16_t usize;
+static uint8_t addr;
+static uint8_t new_addr;
+static uint8_t pattern[FUZZ_PATTERN];
+static uint8_t pkt[0x100];
+#if defined(USBD_SPLIT_ISR)
+static bool irq_pend;
+static bool preempt;
+#endif
+static uint8_t preempt_pkt[8];
+
+static struct usb_device_descriptor device_desc = {
+    .bLength            = sizeof(struct usb_device_descriptor),
+    .bDescriptorType    = USB_DTYPE_DEVICE,
+    .bcdUSB             = VERSION_BCD(2,0,0),
+    .bDeviceClass       = USB_CLASS_VENDOR,
+    .bDeviceSubClass    = USB_SUBCLASS_NONE,
+    .bDeviceProtocol    = USB_PROTO_NONE,
+    .bMaxPacketSize0    = 8,
+    .idVendor           = 0x0483,
+    .idProduct          = 0x5740,
+    .bcdDevice          = VERSION_BCD(1,0,0),
+    .iManufacturer      = 1,
+    .iProduct           = 0,
+    .iSerialNumber      = INTSERIALNO_DESCRIPTOR,
+    .bNumConfigurations = 1,
+};
+
+static const struct {
+    struct usb_config_descriptor    config;
+    struct usb_interface_descriptor iface;
+} __attribute__((packed)) config_desc = {
+    .config = {
+        .bLength                = sizeof(struct usb_config_descriptor),
+        .bDescriptorType        = USB_DTYPE_CONFIGURATION,
+        .wTotalLength           = sizeof(config_desc),
+        .bNumInterfaces         = 1,
+        .bConfigurationValue    = 1,
+        .iConfiguration         = NO_DESCRIPTOR,
+        .bmAttributes           = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+        .bMaxPower              = USB_CFG_POWER_MA(100),
+    },
+    .iface = {
+        .bLength                = sizeof(struct usb_interface_descriptor),
+        .bDescriptorType        = USB_DTYPE_INTERFACE,
+        .bInterfaceNumber       = 0,
+        .bAlternateSetting      = 0,
+        .bNumEndpoints          = 0,
+        .bInterfaceClass        = USB_CLASS_VENDOR,
+        .bInterfaceSubClass     = USB_SUBCLASS_NONE,
+        .bInterfaceProtocol     = USB_PROTO_NONE,
+        .iInterface             = NO_DESCRIPTOR,
+    },
+};
+
+static const struct usb_string_descriptor lang_desc = USB_ARRAY_DESC(USB_LANGID_ENG_US);
+static const struct usb_string_descriptor manuf_desc = USB_STRING_DESC("Fuzzer");
+
+static void fuzz_fail(const char *cond, int line) {
+    fprintf(stderr, "ep0_fuzz: %s failed at line %d, state %d, count %d, ptr %p, buf %p\n",
+            cond, line, udev.status.control_state, udev.status.data_count,
+            udev.status.data_ptr, udev.status.data_buf);
+    abort();
+}
+
+/* checks that [ptr, ptr + len) fits the object */
+static bool fuzz_within(const void *ptr, uint16_t len, const void *obj, size_t size) {
+    const uint8_t *_p = ptr;
+    const uint8_t *_o = obj;
+    return (_p >= _o) && (_p <= _o + size) && (len <= (size_t)(_o + size - _p));
+}
+
+static bool fuzz_tx_source(const void *ptr, uint16_t len) {
+    usbd_ctlreq *const req = udev.status.data_buf;
+    return fuzz_within(ptr, len, req->data, udev.status.data_maxsize) ||
+           fuzz_within(ptr, len, pattern, sizeof(pattern)) ||
+           fuzz_within(ptr, len, &device_desc, sizeof(device_desc)) ||
+           fuzz_within(ptr, len, &config_desc, sizeof(config_desc)) ||
+           fuzz_within(ptr, len, &lang_desc, lang_desc.bLength) ||
+           fuzz_within(ptr, len, &manuf_desc, manuf_desc.bLength);
+}
+
+/* control transfer invariants */
+static void fuzz_check(void) {
+    const usbd_ctlreq *req = udev.status.data_buf;
+    const uint8_t *canary = (uint8_t*)ubuf + usize;
+    FUZZ_CHECK(udev.status.data_buf == ubuf);
+    FUZZ_CHECK(udev.status.data_maxsize == usize - offsetof(usbd_ctlreq, data));
+    for (int i = 0; i < FUZZ_CANARY; i++) {
+        FUZZ_CHECK(canary[i] == 0xA5);
+    }
+    switch (udev.status.control_state) {
+    case usbd_ctl_idle:
+    case usbd_ctl_statusin:
+    case usbd_ctl_statusout:
+    case usbd_ctl_deferred:
+        break;
+    case usbd_ctl_rxdata:
+        FUZZ_CHECK(!(req->bmRequestType & USB_REQ_DEVTOHOST));
+        FUZZ_CHECK(udev.status.data_count <= req->wLength);
+        if (req->wLength <= udev.status.data_maxsize) {
+            FUZZ_CHECK(udev.status.data_ptr ==
+                       req->data + req->wLength - udev.status.data_count);
+        }
+        break;
+    case usbd_ctl_txdata:
+    case usbd_ctl_ztxdata:
+    case usbd_ctl_lastdata:
+        FUZZ_CHECK(req->bmRequestType & USB_REQ_DEVTOHOST);
+        FUZZ_CHECK(udev.status.data_count <= req->wLength);
+#if !defined(USBD_STREAM_DISABLED)
+        if (udev.status.data_ptr == 0) {
+            FUZZ_CHECK(udev.status.data_offset + udev.status.data_count <= req->wLength);
+            break;
+        }
+#endif
+        FUZZ_CHECK(fuzz_tx_source(udev.status.data_ptr, udev.status.data_count));
+        break;
+    default:
+        FUZZ_CHECK(!"valid control state");
+        break;
+    }
+}
+
+#if defined(USBD_SPLIT_ISR)
+/* pends the USB interrupt */
+static void fuzz_irq(usbd_device *dev) {
+    irq_pend = true;
+}
+#define fuzz_irq_pend() irq_pend
+#else
+#define fuzz_irq_pend() false
+#endif
+
+/* services the device interrupts */
+static void fuzz_poll(void) {
+    for (int i = 0; (port->irq() || fuzz_irq_pend()) && (i < FUZZ_POLL_MAX); i++) {
+#if defined(USBD_SPLIT_ISR)
+        irq_pend = false;
+#endif
+        usbd_poll(&udev);
+#if defined(USBD_EVENT_QUEUE)
+        usbd_process_queue(&udev);
+#endif
+#if defined(USBD_SPLIT_ISR)
+        usbd_process_pending(&udev);
+#endif
+        fuzz_check();
+    }
+#if defined(USBD_SPLIT_ISR)
+    usbd_process_pending(&udev);
+    fuzz_check();
+#endif
+}
+
+static usbd_respond fuzz_getdesc(usbd_ctlreq *req, void **address, uint16_t *length) {
+    const uint8_t dtype = req->wValue >> 8;
+    const uint8_t dnumber = req->wValue & 0xFF;
+    const void *desc;
+    uint16_t len;
+    switch (dtype) {
+    case USB_DTYPE_DEVICE:
+        desc = &device_desc;
+        len = sizeof(device_desc);
+        break;
+    case USB_DTYPE_CONFIGURATION:
+        desc = &config_desc;
+        len = sizeof(config_desc);
+        break;
+    case USB_DTYPE_STRING:
+        if (dnumber == 0) {
+            desc = &lang_desc;
+        } else if (dnumber == 1) {
+            desc = &manuf_desc;
+        } else {
+            return usbd_fail;
+        }
+        len = ((const struct usb_string_descriptor*)desc)->bLength;
+        break;
+    default:
+        return usbd_fail;
+    }
+    *address = (void*)desc;
+    *length = len;
+    return usbd_ack;
+}
+
+static void fuzz_rx_complete(usbd_device *dev, usbd_ctlreq *req) {
+    uint8_t _t = 0;
+    FUZZ_CHECK(req->wLength <= dev->status.data_maxsize);
+    for (int i = 0; i < req->wLength; i++) {
+        _t ^= req->data[i];
+    }
+    pattern[0] = _t;
+}
+
+#if !defined(USBD_STREAM_DISABLED)
+static usbd_respond fuzz_stream(usbd_device *dev, usbd_ctlreq *req, uint16_t offset, uint16_t blen) {
+    FUZZ_CHECK(blen <= dev->status.data_maxsize);
+    FUZZ_CHECK((uint32_t)offset + blen <= req->wLength);
+    if (req->bmRequestType & USB_REQ_DEVTOHOST) {
+        for (int i = 0; i < blen; i++) {
+            req->data[i] = (uint8_t)(offset + i);
+        }
+    } else {
+        for (int i = 0; i < blen; i++) {
+            pattern[0] ^= req->data[i];
+        }
+    }
+    return (offset < 0x8000) ? usbd_ack : usbd_fail;
+}
+#endif
+
+static int fuzz_setup(const uint8_t *data);
+
+static usbd_respond fuzz_control(usbd_device *dev, usbd_ctlreq *req, usbd_rqc_callback *callback) {
+#if defined(USBD_SPLIT_ISR)
+    /* USB interrupt preempts the handler */
+    if (preempt) {
+        preempt = false;
+        fuzz_setup(preempt_pkt);
+        for (int i = 0; port->irq() && (i < FUZZ_POLL_MAX); i++) {
+            usbd_poll(dev);
+        }
+    }
+#endif
+    if ((req->bmRequestType & (USB_REQ_TYPE | USB_REQ_RECIPIENT)) != (USB_REQ_VENDOR | USB_REQ_DEVICE)) {
+        return usbd_fail;
+    }
+    switch (req->bRequest) {
+    case 0x01:
+        if (!(req->bmRequestType & USB_REQ_DEVTOHOST)) break;
+        dev->status.data_ptr = pattern;
+        dev->status.data_count = _MIN(req->wValue, sizeof(pattern));
+        return usbd_ack;
+#if !defined(USBD_STREAM_DISABLED)
+    case 0x02:
+        if (!(req->bmRequestType & USB_REQ_DEVTOHOST)) break;
+        usbd_ctl_stream(dev, req->wValue);
+        return usbd_ack;
+#endif
+    case 0x03:
+        if (!(req->bmRequestType & USB_REQ_DEVTOHOST)) break;
+        dev->status.data_count = _MIN(req->wValue, dev->status.data_count);
+        memset(req->data, req->wValue, dev->status.data_count);
+        return usbd_ack;
+    case 0x04:
+        if (req->bmRequestType & USB_REQ_DEVTOHOST) break;
+        if (req->wLength <= dev->status.data_maxsize) {
+            *callback = fuzz_rx_complete;
+        }
+        return usbd_ack;
+    case 0x05:
+        return usbd_nak;
+    default:
+        break;
+    }
+    return usbd_fail;
+}
+
+static usbd_respond fuzz_config(usbd_device *dev, uint8_t cfg) {
+    return (cfg <= 1) ? usbd_ack : usbd_fail;
+}
+
+static int fuzz_setup(const uint8_t *data) {
+    const usbd_ctlreq *req = (const void*)data;
+    if ((req->bmRequestType == 0x00) && (req->bRequest == USB_STD_SET_ADDRESS)) {
+        new_addr = req->wValue & 0x7F;
+    }
+    return port->setup(addr, 0, data);
+}
+
+static void fuzz_init(uint8_t cfg) {
+    static const uint8_t ep0size[] = {8, 16, 32, 64};
+    usize = offsetof(usbd_ctlreq, data) + 2 + (cfg & 0x3F) * 4;
+    ubuf = realloc(ubuf, usize + FUZZ_CANARY);
+    if (ubuf == NULL) abort();
+    memset(ubuf, 0, usize);
+    memset((uint8_t*)ubuf + usize, 0xA5, FUZZ_CANARY);
+    for (size_t i = 0; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 7);
+    }
+    addr = 0;
+    new_addr = 0;
+#if defined(USBD_SPLIT_ISR)
+    irq_pend = false;
+    preempt = false;
+#endif
+    if (!SIM_MODEL_INIT()) abort();
+    memset(&udev, 0, sizeof(udev));
+    device_desc.bMaxPacketSize0 = ep0size[cfg >> 6];
+    usbd_init(&udev, &usbd_hw, device_desc.bMaxPacketSize0, ubuf, usize);
+    usbd_reg_config(&udev, fuzz_config);
+    usbd_reg_control(&udev, fuzz_control);
+    usbd_reg_descr(&udev, fuzz_getdesc);
+#if defined(USBD_SPLIT_ISR)
+    usbd_reg_irq(&udev, fuzz_irq);
+#endif
+#if !defined(USBD_STREAM_DISABLED)
+    usbd_reg_stream(&udev, fuzz_stream);
+#endif
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    fuzz_poll();
+    port->reset();
+    fuzz_poll();
+}
+
+int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+    const uint8_t *end = data + size;
+    if (size < 1) return 0;
+    fuzz_init(*data++);
+    while (data < end) {
+        const uint8_t op = *data++;
+        uint8_t len;
+        bool data1;
+        switch (op & 0x07) {
+        case 0x00:
+            if (end - data < 8) return 0;
+            memcpy(pkt, data, 8);
+            data += 8;
+            fuzz_setup(pkt);
+            break;
+        case 0x01:
+            if (data == end) return 0;
+            len = *data++;
+            len = _MIN(len, end - data);
+            memcpy(pkt, data, len);
+            data += len;
+            port->out(addr, 0, op & 0x08, pkt, len);
+            break;
+        case 0x02:
+            port->in(addr, 0, &data1, pkt, (op >> 4) * 8);
+            break;
+        case 0x03:
+            port->reset();
+            addr = 0;
+            break;
+        case 0x04:
+            if (port->eopf) {
+                port->eopf();
+                fuzz_poll();
+            }
+            port->frame(op & 0x08);
+            break;
+        case 0x05:
+            if (op & 0x08) {
+                usbd_ctl_stall(&udev);
+            } else {
+                usbd_ctl_complete(&udev, pattern, (op >> 4) * 8);
+            }
+            break;
+        case 0x06:
+            addr = (op & 0x08) ? new_addr : 0;
+            if (op & 0x10) {
+                if (end - data < 8) return 0;
+                memcpy(preempt_pkt, data, 8);
+                data += 8;
+#if defined(USBD_SPLIT_ISR)
+                preempt = true;
+#endif
+            }
+            break;
+        default:
+            if (end - data < 2) return 0;
+            pkt[0] = (op & 0x08) ? (USB_REQ_DEVTOHOST | USB_REQ_VENDOR) : USB_REQ_VENDOR;
+            pkt[1] = op >> 4;
+            pkt[2] = data[0];
+            pkt[3] = data[0] >> 6;
+            pkt[4] = 0;
+            pkt[5] = 0;
+            pkt[6] = data[1];
+            pkt[7] = data[1] >> 6;
+            data += 2;
+            fuzz_setup(pkt);
+            break;
+        }
+        fuzz_check();
+        fuzz_poll();
+    }
+    return 0;
+}
+
+#if !defined(EP0_FUZZ_LIBFUZZER)
+/* xorshift32 */
+static uint32_t fuzz_rand(uint32_t *seed) {
+    uint32_t _t = *seed;
+    _t ^= _t << 13;
+    _t ^= _t >> 17;
+    _t ^= _t << 5;
+    return *seed = _t;
+}
+
+/* random script of the mostly well-formed control transfers */
+static size_t fuzz_random(uint8_t *data, uint32_t *seed) {
+    size_t len = 0;
+    data[len++] = fuzz_rand(seed);
+    while (len < FUZZ_INPUT_MAX - 0x110) {
+        const uint32_t r = fuzz_rand(seed);
+        uint8_t op = r & 0xFF;
+        data[len++] = op;
+        switch (op & 0x07) {
+        case 0x00:
+            for (int i = 0; i < 8; i++) {
+                data[len++] = fuzz_rand(seed);
+            }
+            /* mostly standard device requests with the sane wLength and known descriptors */
+            if (r & 0x0100) {
+                data[len - 8] &= USB_REQ_DEVTOHOST | USB_REQ_RECIPIENT;
+                data[len - 7] &= 0x0F;
+                data[len - 1] = 0;
+            }
+            if (r & 0x0200) {
+                static const uint16_t dvalue[] = {0x0100, 0x0200, 0x0300, 0x0301, 0x03FE,
+                                                  0x0600, 0x0700, 0x0F00};
+                const uint16_t _t = dvalue[(r >> 10) & 0x07];
+                data[len - 8] = USB_REQ_DEVTOHOST;
+                data[len - 7] = USB_STD_GET_DESCRIPTOR;
+                data[len - 6] = _t & 0xFF;
+                data[len - 5] = _t >> 8;
+            }
+            break;
+        case 0x01:
+            op = (r >> 8) % 72;
+            data[len++] = op;
+            for (int i = 0; i < op; i++) {
+                data[len++] = fuzz_rand(seed);
+            }
+            break;
+        case 0x07:
+            data[len++] = r >> 8;
+            data[len++] = r >> 16;
+            break;
+        default:
+            break;
+        }
+        if ((r >> 24) == 0) break;
+    }
+    return len;
+}
+
+static int fuzz_file(FILE *f, const char *name) {
+    static uint8_t data[FUZZ_INPUT_MAX];
+    const size_t len = fread(data, 1, sizeof(data), f);
+    if (ferror(f)) {
+        fprintf(stderr, "ep0_fuzz: can't read %s\n", name);
+        return 1;
+    }
+    LLVMFuzzerTestOneInput(data, len);
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    int res = 0;
+    if (argc == 1) {
+        return fuzz_file(stdin, "stdin");
+    }
+    if (strcmp(argv[1], "-r") == 0) {
+        static uint8_t data[FUZZ_INPUT_MAX];
+        const unsigned long count = (argc > 2) ? strtoul(argv[2], NULL, 0) : 10000;
+        uint32_t seed = (argc > 3) ? strtoul(argv[3], NULL, 0) : 1;
+        if (seed == 0) seed = 1;
+        for (unsigned long i = 0; i < count; i++) {
+            LLVMFuzzerTestOneInput(data, fuzz_random(data, &seed));
+        }
+        printf("ep0_fuzz %s: %lu random inputs passed\n", SIM_MODEL_NAME, count);
+        return 0;
+    }
+    for (int i = 1; i < argc; i++) {
+        FILE *f = fopen(argv[i], "rb");
+        if (f == NULL) {
+            fprintf(stderr, "ep0_fuzz: can't open %s\n", argv[i]);
+            res = 1;
+            continue;
+        }
+        res |= fuzz_file(f, argv[i]);
+        fclose(f);
+    }
+    return res;
+}
+#endif
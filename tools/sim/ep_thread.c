@@ -0,0 +1,241 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Writes the doublebuffered bulk IN endpoint from the second thread while the main thread plays
+ * the USB interrupt. The interrupt is injected at random after the register accesses of the
+ * writer, so the writer is preempted between the driver instructions the same way as on the
+ * MCU. Threads never run at the same time: the writer is stopped while the interrupt is served.
+ * Each packet carries it's sequence number and the length derived from it, host checks the
+ * packet contents and the data toggle.
+ *
+ * Usage: ep_thread.sim [packets [seed]]
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "sim_host.h"
+#include "sim_model.h"
+
+#if !defined(SIM_MODEL_OTG)
+    #error ep_thread requires OTG core model
+#endif
+
+#define TX_EP           0x81
+#define TX_SIZE         0x40
+#define TX_DRAIN        0x10        /* IN tokens to drain the preloaded packets */
+
+static struct sim_host host;
+static usbd_device udev;
+static uint32_t ubuf[0x20];
+static pthread_t writer;
+static sem_t irq_go;
+static sem_t irq_done;
+static volatile bool writer_done;
+static uint32_t packets = 0x2000;
+static uint32_t received;
+static uint32_t seed = 1;
+static uint32_t seed0;
+
+static struct usb_device_descriptor device_desc = {
+    .bLength            = sizeof(struct usb_device_descriptor),
+    .bDescriptorType    = USB_DTYPE_DEVICE,
+    .bcdUSB             = VERSION_BCD(2,0,0),
+    .bDeviceClass       = USB_CLASS_VENDOR,
+    .bDeviceSubClass    = USB_SUBCLASS_NONE,
+    .bDeviceProtocol    = USB_PROTO_NONE,
+    .bMaxPacketSize0    = 0x40,
+    .idVendor           = 0x0483,
+    .idProduct          = 0x5740,
+    .bcdDevice          = VERSION_BCD(1,0,0),
+    .iManufacturer      = NO_DESCRIPTOR,
+    .iProduct           = NO_DESCRIPTOR,
+    .iSerialNumber      = NO_DESCRIPTOR,
+    .bNumConfigurations = 1,
+};
+
+static const struct {
+    struct usb_config_descriptor    config;
+    struct usb_interface_descriptor iface;
+    struct usb_endpoint_descriptor  tx;
+} __attribute__((packed)) config_desc = {
+    .config = {
+        .bLength                = sizeof(struct usb_config_descriptor),
+        .bDescriptorType        = USB_DTYPE_CONFIGURATION,
+        .wTotalLength           = sizeof(config_desc),
+        .bNumInterfaces         = 1,
+        .bConfigurationValue    = 1,
+        .iConfiguration         = NO_DESCRIPTOR,
+        .bmAttributes           = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+        .bMaxPower              = USB_CFG_POWER_MA(100),
+    },
+    .iface = {
+        .bLength                = sizeof(struct usb_interface_descriptor),
+        .bDescriptorType        = USB_DTYPE_INTERFACE,
+        .bInterfaceNumber       = 0,
+        .bAlternateSetting      = 0,
+        .bNumEndpoints          = 1,
+        .bInterfaceClass        = USB_CLASS_VENDOR,
+        .bInterfaceSubClass     = USB_SUBCLASS_NONE,
+        .bInterfaceProtocol     = USB_PROTO_NONE,
+        .iInterface             = NO_DESCRIPTOR,
+    },
+    .tx = {
+        .bLength                = sizeof(struct usb_endpoint_descriptor),
+        .bDescriptorType        = USB_DTYPE_ENDPOINT,
+        .bEndpointAddress       = TX_EP,
+        .bmAttributes           = USB_EPTYPE_BULK,
+        .wMaxPacketSize         = TX_SIZE,
+        .bInterval              = 0x00,
+    },
+};
+
+static usbd_respond thread_getdesc(usbd_ctlreq *req, void **address, uint16_t *length) {
+    switch (req->wValue >> 8) {
+    case USB_DTYPE_DEVICE:
+        *address = &device_desc;
+        *length = sizeof(device_desc);
+        return usbd_ack;
+    case USB_DTYPE_CONFIGURATION:
+        *address = (void*)&config_desc;
+        *length = sizeof(config_desc);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+static usbd_respond thread_config(usbd_device *dev, uint8_t cfg) {
+    switch (cfg) {
+    case 0:
+        usbd_ep_deconfig(dev, TX_EP);
+        return usbd_ack;
+    case 1:
+        usbd_ep_config(dev, TX_EP, USB_EPTYPE_BULK | USB_EPTYPE_DBLBUF, TX_SIZE);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+/* packet length and contents are derived from the sequence number */
+static uint16_t packet_len(uint32_t seq) {
+    return 1 + (seq * 7) % TX_SIZE;
+}
+
+static uint8_t packet_byte(uint32_t seq, uint16_t idx) {
+    return (idx < 4) ? (uint8_t)(seq >> (idx * 8)) : (uint8_t)(seq + idx);
+}
+
+static uint32_t xorshift(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/* interrupt injection. Called after each register access */
+static void thread_preempt(void) {
+    if (!pthread_equal(pthread_self(), writer) || (xorshift() & 0x03)) return;
+    sem_post(&irq_go);
+    sem_wait(&irq_done);
+}
+
+static void *thread_writer(void *arg) {
+    uint8_t buf[TX_SIZE];
+    (void)arg;
+    for (uint32_t seq = 0; seq < packets; seq++) {
+        uint16_t len = packet_len(seq);
+        for (uint16_t i = 0; i < len; i++) {
+            buf[i] = packet_byte(seq, i);
+        }
+        while (usbd_ep_write(&udev, TX_EP, buf, len) < 0);
+    }
+    writer_done = true;
+    sem_post(&irq_go);
+    return NULL;
+}
+
+static void thread_fail(const char *what, int len, bool data1) {
+    fprintf(stderr, "ep_thread %s: %s at packet %u (len %d, DATA%d, seed %u)\n", SIM_MODEL_NAME,
+            what, (unsigned)received, len, data1, (unsigned)seed0);
+    exit(1);
+}
+
+/* one IN token from host and the USB interrupt service */
+static void thread_irq(void) {
+    uint8_t pkt[TX_SIZE];
+    bool data1;
+    int res = SIM_MODEL_PORT.in(host.addr, TX_EP & 0x7F, &data1, pkt, sizeof(pkt));
+    if (res >= 0) {
+        if (received >= packets) thread_fail("extra packet", res, data1);
+        if (res != packet_len(received)) thread_fail("wrong length", res, data1);
+        if (data1 != (received & 0x01)) thread_fail("wrong data toggle", res, data1);
+        for (int i = 0; i < res; i++) {
+            if (pkt[i] != packet_byte(received, i)) thread_fail("wrong data", res, data1);
+        }
+        received++;
+    } else if (res != SIM_NAK) {
+        thread_fail("transaction error", res, false);
+    }
+    sim_host_poll(&host);
+}
+
+int main(int argc, char **argv) {
+    if (argc > 1) packets = strtoul(argv[1], NULL, 0);
+    if (argc > 2) seed = strtoul(argv[2], NULL, 0);
+    if (seed == 0) seed = 1;
+    seed0 = seed;
+    if (!SIM_MODEL_INIT()) {
+        fprintf(stderr, "%s: model init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    usbd_init(&udev, &usbd_hw, device_desc.bMaxPacketSize0, ubuf, sizeof(ubuf));
+    usbd_reg_config(&udev, thread_config);
+    usbd_reg_descr(&udev, thread_getdesc);
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    sim_host_init(&host, &SIM_MODEL_PORT, &udev, false);
+    int res = sim_host_enumerate(&host, 1);
+    if (res < 0) {
+        fprintf(stderr, "%s: enumeration failed (%d)\n", SIM_MODEL_NAME, res);
+        return 1;
+    }
+    sem_init(&irq_go, 0, 0);
+    sem_init(&irq_done, 0, 0);
+    otg_model_preempt(thread_preempt);
+    if (pthread_create(&writer, NULL, thread_writer, NULL) != 0) {
+        fprintf(stderr, "%s: can't start writer\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    for (;;) {
+        sem_wait(&irq_go);
+        if (writer_done) break;
+        thread_irq();
+        sem_post(&irq_done);
+    }
+    pthread_join(writer, NULL);
+    otg_model_preempt(NULL);
+    for (int i = 0; (received < packets) && (i < TX_DRAIN); i++) {
+        thread_irq();
+    }
+    if (received != packets) thread_fail("lost packet", 0, false);
+    if (otg_model_stats()->tx_overrun) thread_fail("TX FIFO overrun", 0, false);
+    printf("ep_thread %s: %u packets passed\n", SIM_MODEL_NAME, (unsigned)packets);
+    return 0;
+}
@@ -0,0 +1,245 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* USB 2.0 link power management on the register model. Checks the BOS descriptor with the
+ * USB 2.0 extension served by core, LPM token handshakes for the LPMEN and LPMACK settings,
+ * usbd_evt_l1susp and usbd_evt_l1wkup events and usbd_remote_wakeup() from L1 sleep when the
+ * host allowed it in the LPM token and when it did not.
+ *
+ * Usage: lpm_bus.sim
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "stm32.h"
+#include "sim_host.h"
+#include "sim_model.h"
+
+#if defined(SIM_MODEL_OTG)
+    #if !defined(USBD_STM32F446FS) && !defined(USBD_STM32L476) && !defined(USBD_STM32H743FS)
+        #error lpm_bus requires OTG core with LPM
+    #endif
+    #define LPM_CFG         (((USB_OTG_GlobalTypeDef*)(USB_OTG_FS_PERIPH_BASE + USB_OTG_GLOBAL_BASE))->GLPMCFG)
+    #define LPM_ACK         USB_OTG_GLPMCFG_LPMACK
+#else
+    #if !defined(USB_LPMCSR_LMPEN)
+        #error lpm_bus requires USB device peripheral with LPM
+    #endif
+    #define LPM_CFG         (USB->LPMCSR)
+    #define LPM_ACK         USB_LPMCSR_LPMACK
+#endif
+
+#define LPM_L1          0x01        /* bLinkState L1 */
+#define LPM_BESL(besl)  ((besl) << 4)
+#define LPM_RWAKE       0x100       /* bRemoteWake */
+#define LPM_BBESL       4
+#define LPM_DBESL       12
+
+static struct sim_host host;
+static usbd_device udev;
+static uint32_t ubuf[0x20];
+static uint32_t l1susp;
+static uint32_t l1wkup;
+
+static struct usb_device_descriptor device_desc = {
+    .bLength            = sizeof(struct usb_device_descriptor),
+    .bDescriptorType    = USB_DTYPE_DEVICE,
+    .bcdUSB             = VERSION_BCD(2,0,1),
+    .bDeviceClass       = USB_CLASS_VENDOR,
+    .bDeviceSubClass    = USB_SUBCLASS_NONE,
+    .bDeviceProtocol    = USB_PROTO_NONE,
+    .bMaxPacketSize0    = 0x40,
+    .idVendor           = 0x0483,
+    .idProduct          = 0x5740,
+    .bcdDevice          = VERSION_BCD(1,0,0),
+    .iManufacturer      = NO_DESCRIPTOR,
+    .iProduct           = NO_DESCRIPTOR,
+    .iSerialNumber      = NO_DESCRIPTOR,
+    .bNumConfigurations = 1,
+};
+
+static const struct {
+    struct usb_config_descriptor    config;
+    struct usb_interface_descriptor iface;
+} __attribute__((packed)) config_desc = {
+    .config = {
+        .bLength                = sizeof(struct usb_config_descriptor),
+        .bDescriptorType        = USB_DTYPE_CONFIGURATION,
+        .wTotalLength           = sizeof(config_desc),
+        .bNumInterfaces         = 1,
+        .bConfigurationValue    = 1,
+        .iConfiguration         = NO_DESCRIPTOR,
+        .bmAttributes           = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+        .bMaxPower              = USB_CFG_POWER_MA(100),
+    },
+    .iface = {
+        .bLength                = sizeof(struct usb_interface_descriptor),
+        .bDescriptorType        = USB_DTYPE_INTERFACE,
+        .bInterfaceNumber       = 0,
+        .bAlternateSetting      = 0,
+        .bNumEndpoints          = 0,
+        .bInterfaceClass        = USB_CLASS_VENDOR,
+        .bInterfaceSubClass     = USB_SUBCLASS_NONE,
+        .bInterfaceProtocol     = USB_PROTO_NONE,
+        .iInterface             = NO_DESCRIPTOR,
+    },
+};
+
+static usbd_respond lpm_getdesc(usbd_ctlreq *req, void **address, uint16_t *length) {
+    switch (req->wValue >> 8) {
+    case USB_DTYPE_DEVICE:
+        *address = &device_desc;
+        *length = sizeof(device_desc);
+        return usbd_ack;
+    case USB_DTYPE_CONFIGURATION:
+        *address = (void*)&config_desc;
+        *length = sizeof(config_desc);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+static usbd_respond lpm_config(usbd_device *dev, uint8_t cfg) {
+    (void)dev;
+    return (cfg <= 1) ? usbd_ack : usbd_fail;
+}
+
+static void lpm_evt(usbd_device *dev, uint8_t event, uint8_t ep) {
+    (void)dev;
+    (void)ep;
+    if (event == usbd_evt_l1susp) l1susp++;
+    if (event == usbd_evt_l1wkup) l1wkup++;
+}
+
+static void lpm_fail(const char *what, int res) {
+    fprintf(stderr, "lpm_bus %s: %s (%d)\n", SIM_MODEL_NAME, what, res);
+    exit(1);
+}
+
+static void lpm_expect(const char *what, int res, int expected) {
+    if (res != expected) lpm_fail(what, res);
+}
+
+static bool l1_sleep(void) {
+    return (udev.status.device_status & USBD_STATUS_L1SLEEP) != 0;
+}
+
+/* LPM extended token and the USB interrupt service */
+static int lpm_token(uint16_t attr) {
+    int res = SIM_MODEL_PORT.lpm(host.addr, attr);
+    sim_host_poll(&host);
+    return res;
+}
+
+static int get_bos(void *buf, uint16_t len) {
+    return sim_host_control(&host, USB_REQ_DEVTOHOST | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                            USB_STD_GET_DESCRIPTOR, USB_DTYPE_BOS << 8, 0, buf, len);
+}
+
+/* device is still serving control transfers */
+static void check_alive(const char *what) {
+    uint16_t status;
+    int res = sim_host_control(&host, USB_REQ_DEVTOHOST | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                               USB_STD_GET_STATUS, 0, 0, &status, sizeof(status));
+    lpm_expect(what, res, sizeof(status));
+}
+
+static void check_bos(void) {
+    struct {
+        struct usb_bos_descriptor       bos;
+        struct usb_usb20ext_descriptor  ext;
+    } __attribute__((packed)) d;
+    const uint32_t _attr = USB_USB20EXT_LPM | USB_USB20EXT_BESL | USB_USB20EXT_BBESL_VALID |
+                           USB_USB20EXT_DBESL_VALID | USB_USB20EXT_BBESL(LPM_BBESL) |
+                           USB_USB20EXT_DBESL(LPM_DBESL);
+    /* host reads the header first, then the whole set */
+    lpm_expect("BOS header", get_bos(&d, sizeof(d.bos)), sizeof(d.bos));
+    lpm_expect("BOS wTotalLength", d.bos.wTotalLength, sizeof(d));
+    memset(&d, 0, sizeof(d));
+    lpm_expect("BOS length", get_bos(&d, sizeof(d)), sizeof(d));
+    lpm_expect("BOS bLength", d.bos.bLength, sizeof(d.bos));
+    lpm_expect("BOS bDescriptorType", d.bos.bDescriptorType, USB_DTYPE_BOS);
+    lpm_expect("BOS bNumDeviceCaps", d.bos.bNumDeviceCaps, 1);
+    lpm_expect("USB 2.0 extension bLength", d.ext.bLength, sizeof(d.ext));
+    lpm_expect("USB 2.0 extension bDescriptorType", d.ext.bDescriptorType, USB_DTYPE_DEVCAP);
+    lpm_expect("USB 2.0 extension bDevCapabilityType", d.ext.bDevCapabilityType, USB_DEVCAP_USB20EXT);
+    lpm_expect("USB 2.0 extension bmAttributes", d.ext.bmAttributes, _attr);
+}
+
+int main(void) {
+    uint8_t buf[0x20];
+    int res;
+    if (!SIM_MODEL_INIT()) {
+        fprintf(stderr, "%s: model init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    usbd_init(&udev, &usbd_hw, device_desc.bMaxPacketSize0, ubuf, sizeof(ubuf));
+    usbd_reg_config(&udev, lpm_config);
+    usbd_reg_descr(&udev, lpm_getdesc);
+    usbd_reg_event(&udev, usbd_evt_l1susp, lpm_evt);
+    usbd_reg_event(&udev, usbd_evt_l1wkup, lpm_evt);
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    sim_host_init(&host, &SIM_MODEL_PORT, &udev, false);
+    res = sim_host_enumerate(&host, 1);
+    if (res < 0) lpm_fail("enumeration failed", res);
+
+    /* LPM is off after reset. No BOS, LPM token is stalled */
+    lpm_expect("BOS without LPM", get_bos(buf, sizeof(buf)), SIM_STALL);
+    lpm_expect("LPM without LPMEN", lpm_token(LPM_L1 | LPM_BESL(LPM_BBESL)), SIM_STALL);
+    if (l1susp || l1_sleep()) lpm_fail("L1 sleep without LPMEN", l1susp);
+
+    if (!usbd_lpm_config(&udev, true, LPM_BBESL, LPM_DBESL)) lpm_fail("no LPM in driver", 0);
+    check_bos();
+
+    /* LPMEN without LPMACK. Request is not acknowledged */
+    LPM_CFG &= ~LPM_ACK;
+    lpm_expect("LPM without LPMACK", lpm_token(LPM_L1 | LPM_BESL(LPM_BBESL)), SIM_NYET);
+    if (l1susp || l1_sleep()) lpm_fail("L1 sleep on NYET", l1susp);
+    LPM_CFG |= LPM_ACK;
+
+    /* L1 without remote wake. Device can't wake the host, host resumes */
+    lpm_expect("LPM", lpm_token(LPM_L1 | LPM_BESL(LPM_BBESL)), SIM_ACK);
+    if ((l1susp != 1) || !l1_sleep()) lpm_fail("no usbd_evt_l1susp", l1susp);
+    if (usbd_remote_wakeup(&udev)) lpm_fail("remote wakeup from L1 is not allowed", 0);
+    if (SIM_MODEL_PORT.rwakeup()) lpm_fail("resume signaling from L1 is not allowed", 0);
+    if (!l1_sleep()) lpm_fail("L1 sleep state lost on refused wakeup", 0);
+    SIM_MODEL_PORT.resume();
+    sim_host_poll(&host);
+    if ((l1wkup != 1) || l1_sleep()) lpm_fail("no usbd_evt_l1wkup", l1wkup);
+    check_alive("GET_STATUS after L1 resume");
+
+    /* L1 with remote wake. Device resumes the link */
+    lpm_expect("LPM with remote wake", lpm_token(LPM_L1 | LPM_BESL(LPM_BBESL) | LPM_RWAKE), SIM_ACK);
+    if ((l1susp != 2) || !l1_sleep()) lpm_fail("no usbd_evt_l1susp", l1susp);
+    if (!usbd_remote_wakeup(&udev)) lpm_fail("remote wakeup from L1 is refused", 0);
+    if (!SIM_MODEL_PORT.rwakeup()) lpm_fail("no resume signaling from L1", 0);
+    if (l1_sleep()) lpm_fail("L1 sleep state after remote wakeup", 0);
+    sim_host_poll(&host);
+    if (l1wkup != 1) lpm_fail("usbd_evt_l1wkup on device resume", l1wkup);
+    check_alive("GET_STATUS after L1 remote wakeup");
+
+    /* LPM is off again */
+    if (!usbd_lpm_config(&udev, false, 0, 0)) lpm_fail("no LPM in driver", 0);
+    lpm_expect("BOS after LPM off", get_bos(buf, sizeof(buf)), SIM_STALL);
+    lpm_expect("LPM after LPM off", lpm_token(LPM_L1 | LPM_BESL(LPM_BBESL)), SIM_STALL);
+    if ((l1susp != 2) || l1_sleep()) lpm_fail("L1 sleep after LPM off", l1susp);
+    printf("lpm_bus %s: BOS, LPM handshakes, L1 events and remote wakeup passed\n", SIM_MODEL_NAME);
+    return 0;
+}
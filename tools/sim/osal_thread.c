@@ -0,0 +1,403 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Runs the blocking endpoint I/O of usbd_osal.c over the POSIX threads abstraction. The device
+ * thread loops OUT packets back to the IN endpoint by usbd_ep_read_wait and usbd_ep_write_wait,
+ * the main thread plays the host and the USB interrupt. The CPU mutex is held by the device
+ * thread while it runs and released while it sleeps in the OS calls, so the interrupt never
+ * runs in parallel with the driver calls of the thread.
+ * Script: loopback, endpoint event and semaphore timeouts, stale packet flags after the
+ * configuration is set again, loopback after the rebind.
+ *
+ * Usage: osal_thread.sim [packets]
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <semaphore.h>
+#include "usbd_osal.h"
+#include "sim_host.h"
+#include "sim_model.h"
+
+#if !defined(USBD_OSAL) || !defined(USBD_OSAL_PTHREAD)
+    #error osal_thread requires USBD_OSAL and USBD_OSAL_PTHREAD
+#endif
+
+#define LB_EP           0x01
+#define LB_SIZE         0x40
+#define LB_WAIT         1000        /* ms, wait for the data that must come */
+#define LB_TIMEOUT      20          /* ms, wait for the data that must not come */
+#define LB_SLACK        500         /* ms, scheduler slack for the timeout upper bound */
+
+static struct sim_host host;
+static usbd_device udev;
+static uint32_t ubuf[0x20];
+static struct usbd_osal_pthread os;
+static struct usbd_osal osal;
+static pthread_t worker;
+static pthread_mutex_t cpu = PTHREAD_MUTEX_INITIALIZER;
+static sem_t dev_go;
+static sem_t host_go;
+static uint32_t packets = 0x400;
+static bool out_data1;
+static bool in_data1;
+
+static struct usb_device_descriptor device_desc = {
+    .bLength            = sizeof(struct usb_device_descriptor),
+    .bDescriptorType    = USB_DTYPE_DEVICE,
+    .bcdUSB             = VERSION_BCD(2,0,0),
+    .bDeviceClass       = USB_CLASS_VENDOR,
+    .bDeviceSubClass    = USB_SUBCLASS_NONE,
+    .bDeviceProtocol    = USB_PROTO_NONE,
+    .bMaxPacketSize0    = 0x40,
+    .idVendor           = 0x0483,
+    .idProduct          = 0x5740,
+    .bcdDevice          = VERSION_BCD(1,0,0),
+    .iManufacturer      = NO_DESCRIPTOR,
+    .iProduct           = NO_DESCRIPTOR,
+    .iSerialNumber      = NO_DESCRIPTOR,
+    .bNumConfigurations = 1,
+};
+
+static const struct {
+    struct usb_config_descriptor    config;
+    struct usb_interface_descriptor iface;
+    struct usb_endpoint_descriptor  rx;
+    struct usb_endpoint_descriptor  tx;
+} __attribute__((packed)) config_desc = {
+    .config = {
+        .bLength                = sizeof(struct usb_config_descriptor),
+        .bDescriptorType        = USB_DTYPE_CONFIGURATION,
+        .wTotalLength           = sizeof(config_desc),
+        .bNumInterfaces         = 1,
+        .bConfigurationValue    = 1,
+        .iConfiguration         = NO_DESCRIPTOR,
+        .bmAttributes           = USB_CFG_ATTR_RESERVED | USB_CFG_ATTR_SELFPOWERED,
+        .bMaxPower              = USB_CFG_POWER_MA(100),
+    },
+    .iface = {
+        .bLength                = sizeof(struct usb_interface_descriptor),
+        .bDescriptorType        = USB_DTYPE_INTERFACE,
+        .bInterfaceNumber       = 0,
+        .bAlternateSetting      = 0,
+        .bNumEndpoints          = 2,
+        .bInterfaceClass        = USB_CLASS_VENDOR,
+        .bInterfaceSubClass     = USB_SUBCLASS_NONE,
+        .bInterfaceProtocol     = USB_PROTO_NONE,
+        .iInterface             = NO_DESCRIPTOR,
+    },
+    .rx = {
+        .bLength                = sizeof(struct usb_endpoint_descriptor),
+        .bDescriptorType        = USB_DTYPE_ENDPOINT,
+        .bEndpointAddress       = LB_EP,
+        .bmAttributes           = USB_EPTYPE_BULK,
+        .wMaxPacketSize         = LB_SIZE,
+        .bInterval              = 0x00,
+    },
+    .tx = {
+        .bLength                = sizeof(struct usb_endpoint_descriptor),
+        .bDescriptorType        = USB_DTYPE_ENDPOINT,
+        .bEndpointAddress       = LB_EP | 0x80,
+        .bmAttributes           = USB_EPTYPE_BULK,
+        .wMaxPacketSize         = LB_SIZE,
+        .bInterval              = 0x00,
+    },
+};
+
+static usbd_respond osal_getdesc(usbd_ctlreq *req, void **address, uint16_t *length) {
+    switch (req->wValue >> 8) {
+    case USB_DTYPE_DEVICE:
+        *address = &device_desc;
+        *length = sizeof(device_desc);
+        return usbd_ack;
+    case USB_DTYPE_CONFIGURATION:
+        *address = (void*)&config_desc;
+        *length = sizeof(config_desc);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+static usbd_respond osal_config(usbd_device *dev, uint8_t cfg) {
+    switch (cfg) {
+    case 0:
+        usbd_ep_deconfig(dev, LB_EP);
+        usbd_ep_deconfig(dev, LB_EP | 0x80);
+        return usbd_ack;
+    case 1:
+        usbd_ep_config(dev, LB_EP, USB_EPTYPE_BULK, LB_SIZE);
+        usbd_ep_config(dev, LB_EP | 0x80, USB_EPTYPE_BULK, LB_SIZE);
+        usbd_osal_bind_ep(dev, LB_EP);
+        return usbd_ack;
+    default:
+        return usbd_fail;
+    }
+}
+
+static void osal_fail(const char *what, uint32_t seq, int res) {
+    fprintf(stderr, "osal_thread %s: %s at packet %u (%d)\n", SIM_MODEL_NAME, what,
+            (unsigned)seq, res);
+    exit(1);
+}
+
+static uint32_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* packet length and contents are derived from the sequence number */
+static uint16_t packet_len(uint32_t seq) {
+    return (seq * 7) % (LB_SIZE + 1);
+}
+
+static void packet_fill(uint32_t seq, uint8_t *buf) {
+    for (uint16_t i = 0; i < LB_SIZE; i++) {
+        buf[i] = (uint8_t)(seq * 3 + i);
+    }
+}
+
+static void packet_check(uint32_t seq, const uint8_t *buf, int len, const char *what) {
+    uint8_t ref[LB_SIZE];
+    if (len != packet_len(seq)) osal_fail(what, seq, len);
+    packet_fill(seq, ref);
+    for (int i = 0; i < len; i++) {
+        if (buf[i] != ref[i]) osal_fail(what, seq, len);
+    }
+}
+
+/* OS calls of the device thread release the CPU while it sleeps. The interrupt calls them too */
+static uint32_t osal_flags_wait(void *obj, uint32_t flags, uint32_t timeout) {
+    const bool _t = pthread_equal(pthread_self(), worker);
+    uint32_t _r;
+    if (_t) pthread_mutex_unlock(&cpu);
+    _r = usbd_osal_pthread.flags_wait(obj, flags, timeout);
+    if (_t) pthread_mutex_lock(&cpu);
+    return _r;
+}
+
+static bool osal_sem_take(void *obj, uint32_t timeout) {
+    const bool _t = pthread_equal(pthread_self(), worker);
+    bool _r;
+    if (_t) pthread_mutex_unlock(&cpu);
+    _r = usbd_osal_pthread.sem_take(obj, timeout);
+    if (_t) pthread_mutex_lock(&cpu);
+    return _r;
+}
+
+/* hands control over to the host script and waits for it */
+static void dev_sync(void) {
+    pthread_mutex_unlock(&cpu);
+    sem_post(&host_go);
+    sem_wait(&dev_go);
+    pthread_mutex_lock(&cpu);
+}
+
+/* runs the device thread script up to its next dev_sync() */
+static void host_sync(void) {
+    sem_post(&dev_go);
+    sem_wait(&host_go);
+}
+
+static void dev_loopback(uint32_t base) {
+    uint8_t buf[LB_SIZE];
+    for (uint32_t seq = base; seq < base + packets; seq++) {
+        int res = usbd_ep_read_wait(&udev, LB_EP, buf, sizeof(buf), LB_WAIT);
+        if (res < 0) osal_fail("device read failed", seq, res);
+        res = usbd_ep_write_wait(&udev, LB_EP, buf, res, LB_WAIT);
+        if (res < 0) osal_fail("device write failed", seq, res);
+    }
+}
+
+/* checks that the call returned -1 after the timeout. Each of two waits may take it */
+static void dev_timeout(int res, uint32_t start, uint32_t seq, const char *what) {
+    const uint32_t _d = now_ms() - start;
+    if (res >= 0) osal_fail(what, seq, res);
+    if ((_d < LB_TIMEOUT) || (_d > 2 * LB_TIMEOUT + LB_SLACK)) osal_fail(what, seq, _d);
+}
+
+static void *osal_worker(void *arg) {
+    uint8_t buf[LB_SIZE];
+    uint32_t _s;
+    (void)arg;
+    pthread_mutex_lock(&cpu);
+    dev_loopback(0);
+    dev_sync();
+    /* no OUT packet */
+    _s = now_ms();
+    dev_timeout(usbd_ep_read_wait(&udev, LB_EP, buf, sizeof(buf), LB_TIMEOUT), _s, 0,
+                "read without packet");
+    /* IN endpoint is busy until host takes packet 1 */
+    packet_fill(1, buf);
+    if (usbd_ep_write_wait(&udev, LB_EP, buf, packet_len(1), LB_WAIT) < 0) {
+        osal_fail("write to idle endpoint", 1, -1);
+    }
+    _s = now_ms();
+    packet_fill(2, buf);
+    dev_timeout(usbd_ep_write_wait(&udev, LB_EP, buf, packet_len(2), LB_TIMEOUT), _s, 2,
+                "write to busy endpoint");
+    dev_sync();
+    /* OUT packet 3 is received, host holds the semaphore */
+    _s = now_ms();
+    dev_timeout(usbd_ep_read_wait(&udev, LB_EP, buf, sizeof(buf), LB_TIMEOUT), _s, 3,
+                "read while locked");
+    dev_sync();
+    /* packet 3 is still there */
+    packet_check(3, buf, usbd_ep_read_wait(&udev, LB_EP, buf, sizeof(buf), LB_WAIT),
+                 "read after unlock");
+    /* packet 4 is left in the IN endpoint */
+    packet_fill(4, buf);
+    if (usbd_ep_write_wait(&udev, LB_EP, buf, packet_len(4), LB_WAIT) < 0) {
+        osal_fail("write before rebind", 4, -1);
+    }
+    dev_sync();
+    /* configuration was set again. stale OUT packet 5 and IN packet 4 are dropped */
+    _s = now_ms();
+    dev_timeout(usbd_ep_read_wait(&udev, LB_EP, buf, sizeof(buf), LB_TIMEOUT), _s, 5,
+                "stale OUT packet after rebind");
+    packet_fill(6, buf);
+    _s = now_ms();
+    if (usbd_ep_write_wait(&udev, LB_EP, buf, packet_len(6), LB_TIMEOUT) < 0) {
+        osal_fail("IN endpoint is not idle after rebind", 6, now_ms() - _s);
+    }
+    dev_sync();
+    dev_loopback(packets);
+    pthread_mutex_unlock(&cpu);
+    return NULL;
+}
+
+/* one transaction and the USB interrupt service while device thread sleeps */
+static int host_out(uint32_t seq) {
+    uint8_t buf[LB_SIZE];
+    const uint32_t _s = now_ms();
+    packet_fill(seq, buf);
+    for (;;) {
+        pthread_mutex_lock(&cpu);
+        int res = SIM_MODEL_PORT.out(host.addr, LB_EP, out_data1, buf, packet_len(seq));
+        sim_host_poll(&host);
+        pthread_mutex_unlock(&cpu);
+        if (res == SIM_ACK) {
+            out_data1 = !out_data1;
+            return res;
+        }
+        if ((res != SIM_NAK) || (now_ms() - _s > LB_WAIT)) return res;
+        sched_yield();
+    }
+}
+
+static int host_in(uint8_t *buf) {
+    const uint32_t _s = now_ms();
+    bool data1;
+    for (;;) {
+        pthread_mutex_lock(&cpu);
+        int res = SIM_MODEL_PORT.in(host.addr, LB_EP, &data1, buf, LB_SIZE);
+        sim_host_poll(&host);
+        pthread_mutex_unlock(&cpu);
+        if (res >= 0) {
+            if (data1 != in_data1) return SIM_NORESP;
+            in_data1 = !in_data1;
+            return res;
+        }
+        if ((res != SIM_NAK) || (now_ms() - _s > LB_WAIT)) return res;
+        sched_yield();
+    }
+}
+
+static void host_loopback(uint32_t base) {
+    uint8_t buf[LB_SIZE];
+    for (uint32_t seq = base; seq < base + packets; seq++) {
+        int res = host_out(seq);
+        if (res < 0) osal_fail("host OUT failed", seq, res);
+        packet_check(seq, buf, host_in(buf), "loopback");
+    }
+}
+
+int main(int argc, char **argv) {
+    uint8_t buf[LB_SIZE];
+    int res;
+    if (argc > 1) packets = strtoul(argv[1], NULL, 0);
+    if (!SIM_MODEL_INIT()) {
+        fprintf(stderr, "%s: model init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    usbd_init(&udev, &usbd_hw, device_desc.bMaxPacketSize0, ubuf, sizeof(ubuf));
+    if (!usbd_osal_pthread_init(&udev, &os)) {
+        fprintf(stderr, "%s: OSAL init failed\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    osal = usbd_osal_pthread;
+    osal.flags_wait = osal_flags_wait;
+    osal.sem_take = osal_sem_take;
+    usbd_osal_init(&udev, &osal, &os, &os.sem);
+    usbd_reg_config(&udev, osal_config);
+    usbd_reg_descr(&udev, osal_getdesc);
+    usbd_enable(&udev, true);
+    usbd_connect(&udev, true);
+    sim_host_init(&host, &SIM_MODEL_PORT, &udev, false);
+    res = sim_host_enumerate(&host, 1);
+    if (res < 0) {
+        fprintf(stderr, "%s: enumeration failed (%d)\n", SIM_MODEL_NAME, res);
+        return 1;
+    }
+    sem_init(&dev_go, 0, 0);
+    sem_init(&host_go, 0, 0);
+    if (pthread_create(&worker, NULL, osal_worker, NULL) != 0) {
+        fprintf(stderr, "%s: can't start device thread\n", SIM_MODEL_NAME);
+        return 1;
+    }
+    host_loopback(0);
+    sem_wait(&host_go);
+    /* read and write timeouts */
+    host_sync();
+    packet_check(1, buf, host_in(buf), "packet before write timeout");
+    /* semaphore timeout */
+    sem_wait(&os.sem);
+    res = host_out(3);
+    if (res < 0) osal_fail("host OUT failed", 3, res);
+    host_sync();
+    sem_post(&os.sem);
+    host_sync();
+    /* rebind with the stale packets in both directions. Unread OUT packet blocks the OTG RX FIFO
+     * for SETUP too, so OUT is stale on the devfs only */
+#if !defined(SIM_MODEL_OTG)
+    res = host_out(5);
+    if (res < 0) osal_fail("host OUT failed", 5, res);
+#endif
+    pthread_mutex_lock(&cpu);
+    res = sim_host_control(&host, USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                           USB_STD_SET_CONFIG, 0, 0, NULL, 0);
+    if (res >= 0) {
+        res = sim_host_control(&host, USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                               USB_STD_SET_CONFIG, 1, 0, NULL, 0);
+    }
+    pthread_mutex_unlock(&cpu);
+    if (res < 0) osal_fail("SET_CONFIGURATION failed", 5, res);
+    out_data1 = false;
+    in_data1 = false;
+    host_sync();
+    packet_check(6, buf, host_in(buf), "packet after rebind");
+    sem_post(&dev_go);
+    host_loopback(packets);
+    pthread_join(worker, NULL);
+    printf("osal_thread %s: %u packets passed, timeouts and rebind passed\n", SIM_MODEL_NAME,
+           (unsigned)(2 * packets));
+    return 0;
+}
@@ -0,0 +1,767 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <signal.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "stm32.h"
+#include "usb.h"
+#include "otg_model.h"
+
+#if !defined(__linux__) || !defined(__x86_64__)
+    #error OTG register model requires x86-64 Linux
+#endif
+
+/* Core parameters. Must match the driver */
+struct core_preset {
+    uint32_t            base;
+    volatile uint32_t  *rcc_enr;
+    uint32_t            rcc_en;
+    uint16_t            ram_words;
+    uint8_t             max_ep;
+};
+
+static const struct core_preset presets[2] = {
+#if defined(USBD_STM32F429FS)
+    [0] = {USB_OTG_FS_PERIPH_BASE, &RCC->AHB2ENR, RCC_AHB2ENR_OTGFSEN, 320, 4},
+#elif defined(USBD_STM32F105)
+    [0] = {USB_OTG_FS_PERIPH_BASE, &RCC->AHBENR, RCC_AHBENR_OTGFSEN, 320, 4},
+#elif defined(USBD_STM32F446FS) || defined(USBD_STM32L476)
+    [0] = {USB_OTG_FS_PERIPH_BASE, &RCC->AHB2ENR, RCC_AHB2ENR_OTGFSEN, 320, 6},
+#elif defined(USBD_STM32H743FS)
+    [0] = {USB_OTG_FS_PERIPH_BASE, &RCC->AHB1ENR, RCC_AHB1ENR_USB2OTGFSEN, 320, 6},
+#endif
+#if defined(USBD_STM32F429HS)
+    [1] = {USB_OTG_HS_PERIPH_BASE, &RCC->AHB1ENR, RCC_AHB1ENR_OTGHSEN, 1024, 6},
+#elif defined(USBD_STM32F446HS)
+    [1] = {USB_OTG_HS_PERIPH_BASE, &RCC->AHB1ENR, RCC_AHB1ENR_OTGHSEN, 1024, 9},
+#endif
+};
+
+#define MAX_EP          16
+#define CORE_SPAN       0x10000     /* CSR and FIFO windows of EP0..14 */
+#define REG_PAGE        0x1000
+#define FIFO_DEPTH      1024        /* FIFO queue storage in 32-bit words */
+#define EFL_TF          0x100       /* x86 trap flag */
+#define PF_WRITE        0x02        /* page fault error code. Write access */
+
+#define FIFO_WORDS(x)   (((x) + 0x03) >> 2)
+
+/* register offsets */
+#define G_OFF(r)        (USB_OTG_GLOBAL_BASE + offsetof(USB_OTG_GlobalTypeDef, r))
+#define D_OFF(r)        (USB_OTG_DEVICE_BASE + offsetof(USB_OTG_DeviceTypeDef, r))
+#define IN_OFF(r)       offsetof(USB_OTG_INEndpointTypeDef, r)
+#define OUT_OFF(r)      offsetof(USB_OTG_OUTEndpointTypeDef, r)
+
+/* GINTSTS bits by the access type */
+#define GINTSTS_RC_W1   0xF8F0FC0A
+#define GINTSTS_RO      (USB_OTG_GINTSTS_RXFLVL | USB_OTG_GINTSTS_IEPINT | USB_OTG_GINTSTS_OEPINT)
+
+/* DxEPCTL bits. Same layout for IN and OUT */
+#define EPCTL_RO        (USB_OTG_DIEPCTL_EONUM_DPID | USB_OTG_DIEPCTL_NAKSTS)
+#define EPCTL_ACTION    (USB_OTG_DIEPCTL_CNAK | USB_OTG_DIEPCTL_SNAK | USB_OTG_DIEPCTL_EPDIS | \
+                         USB_OTG_DIEPCTL_SD0PID_SEVNFRM | USB_OTG_DIEPCTL_SODDFRM)
+#define EPCTL_ISO_ARMED (USB_OTG_DIEPCTL_EPTYP | USB_OTG_DIEPCTL_EPENA)
+#define EPTYP_ISO       (0x01 << 18)
+
+/* RX FIFO status entries */
+#define PKTSTS_OUT          0x02
+#define PKTSTS_OUT_DONE     0x03
+#define PKTSTS_SETUP_DONE   0x04
+#define PKTSTS_SETUP        0x06
+#define RXSTS_DATA1         (0x02 << USB_OTG_GRXSTSP_DPID_Pos)
+
+struct fifo {
+    uint32_t    data[FIFO_DEPTH];
+    uint16_t    head;
+    uint16_t    count;
+};
+
+static const struct core_preset *core;
+static uint8_t *view;           /* driver side mapping. No access, each access is trapped */
+static uint8_t *regs;           /* model side mapping of the same memory */
+
+static struct fifo rxf;
+static uint16_t rx_stat;        /* status entries in RX FIFO */
+static uint16_t rx_left;        /* data words of the popped packet */
+static struct fifo txf[MAX_EP];
+static bool ep0_in_data1;
+static bool ep0_out_data1;
+static uint8_t missed_sof;
+static bool rwusig;
+static int16_t addr_old;        /* address before SET_ADDRESS until it's status stage. -1 if none */
+static struct otg_model_stats stats;
+static void (*preempt)(void);   /* interrupt injection hook */
+
+static struct {
+    bool        active;
+    bool        write;
+    uint32_t    off;
+    uint32_t    old;
+    uint8_t    *page;
+} step;
+
+#define GLB     ((USB_OTG_GlobalTypeDef*)(regs + USB_OTG_GLOBAL_BASE))
+#define DEV     ((USB_OTG_DeviceTypeDef*)(regs + USB_OTG_DEVICE_BASE))
+
+inline static volatile uint32_t *reg(uint32_t off) {
+    return (volatile uint32_t*)(regs + off);
+}
+
+inline static USB_OTG_INEndpointTypeDef *epin(int ep) {
+    return (void*)(regs + USB_OTG_IN_ENDPOINT_BASE + ep * USB_OTG_EP_REG_SIZE);
+}
+
+inline static USB_OTG_OUTEndpointTypeDef *epout(int ep) {
+    return (void*)(regs + USB_OTG_OUT_ENDPOINT_BASE + ep * USB_OTG_EP_REG_SIZE);
+}
+
+static bool fifo_push(struct fifo *f, uint32_t w) {
+    if (f->count == FIFO_DEPTH) return false;
+    f->data[(f->head + f->count++) % FIFO_DEPTH] = w;
+    return true;
+}
+
+static uint32_t fifo_pop(struct fifo *f) {
+    if (f->count == 0) return 0;
+    uint32_t w = f->data[f->head];
+    f->head = (f->head + 1) % FIFO_DEPTH;
+    f->count--;
+    return w;
+}
+
+static void fifo_flush(struct fifo *f) {
+    f->head = 0;
+    f->count = 0;
+}
+
+inline static uint16_t min16(uint32_t a, uint32_t b) {
+    return (a < b) ? a : b;
+}
+
+/** \brief Returns free RX FIFO space in 32-bit words */
+static uint16_t rx_free(void) {
+    uint16_t depth = min16(GLB->GRXFSIZ & 0xFFFF, FIFO_DEPTH);
+    return (depth > rxf.count) ? depth - rxf.count : 0;
+}
+
+/** \brief Returns TX FIFO depth of the IN endpoint in 32-bit words */
+static uint16_t tx_depth(int ep) {
+    uint32_t t = ep ? GLB->DIEPTXF[ep - 1] : GLB->DIEPTXF0_HNPTXFSIZ;
+    return min16(t >> 16, FIFO_DEPTH);
+}
+
+static void rx_flush(void) {
+    fifo_flush(&rxf);
+    rx_stat = 0;
+    rx_left = 0;
+}
+
+/** \brief Pushes status entry and packet data to RX FIFO. Space must be checked by caller. */
+static void rx_packet(uint32_t sts, const uint8_t *buf, uint16_t len) {
+    fifo_push(&rxf, sts);
+    for (uint16_t n = 0; n < len; n += 4) {
+        uint32_t w = 0;
+        for (int i = 0; (i < 4) && (n + i < len); i++) {
+            w |= (uint32_t)buf[n + i] << (i * 8);
+        }
+        fifo_push(&rxf, w);
+    }
+    rx_stat++;
+    if (rxf.count > stats.rx_peak) stats.rx_peak = rxf.count;
+}
+
+/** \brief Drops unread data of the popped packet. RX FIFO head is a status entry after it. */
+static void rx_skip(void) {
+    for (; rx_left; rx_left--) fifo_pop(&rxf);
+}
+
+static uint32_t rx_pop_status(void) {
+    rx_skip();
+    if (rx_stat == 0) return 0;
+    uint32_t sts = fifo_pop(&rxf);
+    int ep = sts & USB_OTG_GRXSTSP_EPNUM;
+    rx_stat--;
+    rx_left = FIFO_WORDS(_FLD2VAL(USB_OTG_GRXSTSP_BCNT, sts));
+    /* transfer and SETUP stage complete interrupts are raised when the entry is popped */
+    switch (_FLD2VAL(USB_OTG_GRXSTSP_PKTSTS, sts)) {
+    case PKTSTS_OUT_DONE:
+        epout(ep)->DOEPINT |= USB_OTG_DOEPINT_XFRC;
+        break;
+    case PKTSTS_SETUP_DONE:
+        epout(ep)->DOEPINT |= USB_OTG_DOEPINT_STUP;
+        break;
+    default:
+        break;
+    }
+    return sts;
+}
+
+static void tx_push(int ep, uint32_t w) {
+    if ((ep >= core->max_ep) || (txf[ep].count >= tx_depth(ep))) {
+        stats.tx_overrun++;
+        return;
+    }
+    fifo_push(&txf[ep], w);
+    if (txf[ep].count > stats.tx_peak[ep]) stats.tx_peak[ep] = txf[ep].count;
+}
+
+/** \brief Updates DAINT and read only GINTSTS flags */
+static void update_int(void) {
+    uint32_t daint = 0;
+    for (int ep = 0; ep < core->max_ep; ep++) {
+        if (epin(ep)->DIEPINT & DEV->DIEPMSK & ~USB_OTG_DIEPINT_TXFE) daint |= 0x0001UL << ep;
+        if (epout(ep)->DOEPINT & DEV->DOEPMSK) daint |= 0x10000UL << ep;
+    }
+    DEV->DAINT = daint;
+    uint32_t sts = GLB->GINTSTS & ~GINTSTS_RO;
+    if (rx_stat) sts |= USB_OTG_GINTSTS_RXFLVL;
+    if (daint & DEV->DAINTMSK & 0x0000FFFF) sts |= USB_OTG_GINTSTS_IEPINT;
+    if (daint & DEV->DAINTMSK & 0xFFFF0000) sts |= USB_OTG_GINTSTS_OEPINT;
+    GLB->GINTSTS = sts;
+}
+
+static void soft_reset(void) {
+    rx_flush();
+    for (int ep = 0; ep < MAX_EP; ep++) fifo_flush(&txf[ep]);
+}
+
+/** \brief Applies DxEPCTL write. Action bits are not stored, EPENA is cleared by core only. */
+static uint32_t epctl_write(int ep, uint32_t old, uint32_t val, volatile uint32_t *epint) {
+    uint32_t r = (val & ~(EPCTL_RO | EPCTL_ACTION | USB_OTG_DIEPCTL_EPENA)) |
+                 (old & (EPCTL_RO | USB_OTG_DIEPCTL_EPENA)) | (val & USB_OTG_DIEPCTL_EPENA);
+    if (val & USB_OTG_DIEPCTL_SNAK) r |= USB_OTG_DIEPCTL_NAKSTS;
+    if (val & USB_OTG_DIEPCTL_CNAK) r &= ~USB_OTG_DIEPCTL_NAKSTS;
+    if (val & USB_OTG_DIEPCTL_SD0PID_SEVNFRM) r &= ~USB_OTG_DIEPCTL_EONUM_DPID;
+    if (val & USB_OTG_DIEPCTL_SODDFRM) r |= USB_OTG_DIEPCTL_EONUM_DPID;
+    if ((val & USB_OTG_DIEPCTL_EPDIS) && (old & USB_OTG_DIEPCTL_EPENA)) {
+        r &= ~USB_OTG_DIEPCTL_EPENA;
+        *epint |= USB_OTG_DIEPINT_EPDISD;
+    }
+    /* EP0 is always active */
+    if (ep == 0) r |= USB_OTG_DIEPCTL_USBAEP;
+    return r;
+}
+
+/** \brief Prepares register value before the trapped read */
+static void reg_read(uint32_t off) {
+    if (off >= USB_OTG_FIFO_BASE) {
+        /* any FIFO window pops RX FIFO */
+        uint32_t w = 0;
+        if (rx_left) {
+            rx_left--;
+            w = fifo_pop(&rxf);
+        }
+        *reg(off) = w;
+        return;
+    }
+    if ((off >= USB_OTG_IN_ENDPOINT_BASE) &&
+        (off < USB_OTG_IN_ENDPOINT_BASE + MAX_EP * USB_OTG_EP_REG_SIZE)) {
+        int ep = (off - USB_OTG_IN_ENDPOINT_BASE) / USB_OTG_EP_REG_SIZE;
+        USB_OTG_INEndpointTypeDef *epi = epin(ep);
+        switch (off % USB_OTG_EP_REG_SIZE) {
+        case IN_OFF(DTXFSTS):
+            epi->DTXFSTS = tx_depth(ep) - min16(txf[ep].count, tx_depth(ep));
+            break;
+        case IN_OFF(DIEPINT):
+            if (txf[ep].count) {
+                epi->DIEPINT &= ~USB_OTG_DIEPINT_TXFE;
+            } else {
+                epi->DIEPINT |= USB_OTG_DIEPINT_TXFE;
+            }
+            break;
+        default:
+            break;
+        }
+        return;
+    }
+    switch (off) {
+    case G_OFF(GINTSTS):
+    case D_OFF(DAINT):
+        update_int();
+        break;
+    case G_OFF(GRXSTSR):
+        rx_skip();
+        *reg(off) = rx_stat ? rxf.data[rxf.head] : 0;
+        break;
+    case G_OFF(GRXSTSP):
+        *reg(off) = rx_pop_status();
+        break;
+    default:
+        break;
+    }
+}
+
+/** \brief Applies the trapped write */
+static void reg_write(uint32_t off, uint32_t val) {
+    if (off >= USB_OTG_FIFO_BASE) {
+        tx_push((off - USB_OTG_FIFO_BASE) / USB_OTG_FIFO_SIZE, val);
+        return;
+    }
+    if ((off >= USB_OTG_IN_ENDPOINT_BASE) &&
+        (off < USB_OTG_IN_ENDPOINT_BASE + MAX_EP * USB_OTG_EP_REG_SIZE)) {
+        int ep = (off - USB_OTG_IN_ENDPOINT_BASE) / USB_OTG_EP_REG_SIZE;
+        USB_OTG_INEndpointTypeDef *epi = epin(ep);
+        switch (off % USB_OTG_EP_REG_SIZE) {
+        case IN_OFF(DIEPCTL):
+            epi->DIEPCTL = epctl_write(ep, epi->DIEPCTL, val, &epi->DIEPINT);
+            break;
+        case IN_OFF(DIEPINT):
+            epi->DIEPINT &= ~val;
+            break;
+        case IN_OFF(DTXFSTS):
+            break;
+        default:
+            *reg(off) = val;
+            break;
+        }
+        return;
+    }
+    if ((off >= USB_OTG_OUT_ENDPOINT_BASE) &&
+        (off < USB_OTG_OUT_ENDPOINT_BASE + MAX_EP * USB_OTG_EP_REG_SIZE)) {
+        int ep = (off - USB_OTG_OUT_ENDPOINT_BASE) / USB_OTG_EP_REG_SIZE;
+        USB_OTG_OUTEndpointTypeDef *epo = epout(ep);
+        switch (off % USB_OTG_EP_REG_SIZE) {
+        case OUT_OFF(DOEPCTL):
+            epo->DOEPCTL = epctl_write(ep, epo->DOEPCTL, val, &epo->DOEPINT);
+            break;
+        case OUT_OFF(DOEPINT):
+            epo->DOEPINT &= ~val;
+            break;
+        default:
+            *reg(off) = val;
+            break;
+        }
+        return;
+    }
+    switch (off) {
+    case G_OFF(GINTSTS):
+        GLB->GINTSTS &= ~(val & GINTSTS_RC_W1);
+        break;
+    case G_OFF(GRSTCTL):
+        /* reset and flushes are completed immediately, AHB is always idle */
+        if (val & USB_OTG_GRSTCTL_CSRST) soft_reset();
+        if (val & USB_OTG_GRSTCTL_RXFFLSH) rx_flush();
+        if (val & USB_OTG_GRSTCTL_TXFFLSH) {
+            uint32_t n = _FLD2VAL(USB_OTG_GRSTCTL_TXFNUM, val);
+            for (uint32_t ep = 0; ep < MAX_EP; ep++) {
+                if ((n == 0x10) || (n == ep)) fifo_flush(&txf[ep]);
+            }
+        }
+        GLB->GRSTCTL = (val & USB_OTG_GRSTCTL_TXFNUM) | USB_OTG_GRSTCTL_AHBIDL;
+        break;
+    case G_OFF(GRXSTSR):
+    case G_OFF(GRXSTSP):
+    case D_OFF(DSTS):
+    case D_OFF(DAINT):
+        break;
+    case D_OFF(DCFG):
+        /* address is set before the status stage, status IN is sent with the old address */
+        if ((val ^ DEV->DCFG) & USB_OTG_DCFG_DAD) addr_old = _FLD2VAL(USB_OTG_DCFG_DAD, DEV->DCFG);
+        DEV->DCFG = val;
+        break;
+    case D_OFF(DCTL):
+        if (val & USB_OTG_DCTL_RWUSIG) rwusig = true;
+        DEV->DCTL = val;
+        break;
+    default:
+        *reg(off) = val;
+        break;
+    }
+}
+
+/* Driver access trap. The faulting instruction is executed by single step with the register
+ * page opened. Pop on read values are prepared before the step, writes are applied after. */
+static void on_access(int sig, siginfo_t *si, void *ctx) {
+    ucontext_t *uc = ctx;
+    uint8_t *addr = si->si_addr;
+    (void)sig;
+    if (step.active || (addr < view) || (addr >= view + CORE_SPAN)) {
+        /* not a register access */
+        signal(SIGSEGV, SIG_DFL);
+        return;
+    }
+    stats.accesses++;
+    step.off = (addr - view) & ~0x03;
+    step.page = view + (step.off & ~(REG_PAGE - 1));
+    step.write = (uc->uc_mcontext.gregs[REG_ERR] & PF_WRITE) != 0;
+    if (!step.write) reg_read(step.off);
+    step.old = *reg(step.off);
+    mprotect(step.page, REG_PAGE, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= EFL_TF;
+    step.active = true;
+}
+
+static void on_step(int sig, siginfo_t *si, void *ctx) {
+    ucontext_t *uc = ctx;
+    (void)sig;
+    (void)si;
+    if (!step.active) {
+        signal(SIGTRAP, SIG_DFL);
+        raise(SIGTRAP);
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~EFL_TF;
+    mprotect(step.page, REG_PAGE, PROT_NONE);
+    step.active = false;
+    uint32_t val = *reg(step.off);
+    /* read-modify-write instructions can be reported as read */
+    if (step.write || (val != step.old)) {
+        *reg(step.off) = step.old;
+        reg_write(step.off, val);
+    }
+    if (preempt) preempt();
+}
+
+static bool map_core(uint32_t base) {
+    struct sigaction sa;
+    int fd = memfd_create("otg_model", 0);
+    if (fd < 0) return false;
+    if (ftruncate(fd, CORE_SPAN) != 0) {
+        close(fd);
+        return false;
+    }
+    void *v = mmap((void*)(uintptr_t)base, CORE_SPAN, PROT_NONE,
+                   MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0);
+    void *r = mmap(NULL, CORE_SPAN, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if ((v != (void*)(uintptr_t)base) || (r == MAP_FAILED)) {
+        if (v != MAP_FAILED) munmap(v, CORE_SPAN);
+        if (r != MAP_FAILED) munmap(r, CORE_SPAN);
+        return false;
+    }
+    view = v;
+    regs = r;
+    memset(&sa, 0, sizeof(sa));
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_SIGINFO;
+    sa.sa_sigaction = on_access;
+    sigaction(SIGSEGV, &sa, NULL);
+    sa.sa_sigaction = on_step;
+    sigaction(SIGTRAP, &sa, NULL);
+    return true;
+}
+
+bool otg_model_init(bool hs) {
+    const struct core_preset *p = &presets[hs ? 1 : 0];
+    if (p->base == 0) return false;
+    if (core == NULL) {
+        if (!map_core(p->base)) return false;
+    } else if (core != p) {
+        /* one core per process */
+        return false;
+    }
+    core = p;
+    memset((void*)&sim_rcc, 0, sizeof(sim_rcc));
+    memset((void*)&sim_pwr, 0, sizeof(sim_pwr));
+    memset(regs, 0, CORE_SPAN);
+    GLB->GRSTCTL = USB_OTG_GRSTCTL_AHBIDL;
+    GLB->GRXFSIZ = 0x200;
+    GLB->DIEPTXF0_HNPTXFSIZ = 0x200;
+    for (int i = 0; i < 0x0F; i++) {
+        GLB->DIEPTXF[i] = 0x02000400;
+    }
+    epin(0)->DIEPCTL = USB_OTG_DIEPCTL_USBAEP;
+    epout(0)->DOEPCTL = USB_OTG_DOEPCTL_USBAEP;
+    soft_reset();
+    memset(&stats, 0, sizeof(stats));
+    ep0_in_data1 = false;
+    ep0_out_data1 = false;
+    missed_sof = 0;
+    rwusig = false;
+    addr_old = -1;
+    return true;
+}
+
+bool otg_model_irq(void) {
+    if (!core || !(GLB->GAHBCFG & USB_OTG_GAHBCFG_GINT)) return false;
+    update_int();
+    return (GLB->GINTSTS & GLB->GINTMSK) != 0;
+}
+
+bool otg_model_attached(void) {
+    if (!core || !(*core->rcc_enr & core->rcc_en)) return false;
+    uint32_t cfg = GLB->GUSBCFG;
+    if (!(cfg & USB_OTG_GUSBCFG_FDMOD) || (DEV->DCTL & USB_OTG_DCTL_SDIS)) return false;
+    /* embedded FS PHY is powered up by GCCFG_PWRDWN, ULPI PHY is always on */
+    return !(cfg & USB_OTG_GUSBCFG_PHYSEL) || (GLB->GCCFG & USB_OTG_GCCFG_PWRDWN);
+}
+
+/** \brief Checks token address. Returns FALSE if the device doesn't respond. */
+static bool addressed(uint8_t addr, uint8_t ep) {
+    if (!otg_model_attached() || (ep >= core->max_ep)) return false;
+    if (_FLD2VAL(USB_OTG_DCFG_DAD, DEV->DCFG) == addr) return true;
+    return (ep == 0) && (addr_old == addr);
+}
+
+/** \brief Returns max packet size of the endpoint. EP0 uses 2 bit MPSIZ code. */
+static uint16_t ep_mps(int ep, uint32_t ctl) {
+    if (ep == 0) return 0x40 >> (ctl & 0x03);
+    return _FLD2VAL(USB_OTG_DIEPCTL_MPSIZ, ctl);
+}
+
+/** \brief Returns current frame parity */
+static uint32_t frame_odd(void) {
+    return _FLD2VAL(USB_OTG_DSTS_FNSOF, DEV->DSTS) & 0x01;
+}
+
+void otg_model_reset(void) {
+    if (!core) return;
+    uint32_t spd = (_FLD2VAL(USB_OTG_DCFG_DSPD, DEV->DCFG) == 0x00) ? 0x00 : 0x03;
+    DEV->DCFG &= ~USB_OTG_DCFG_DAD;
+    addr_old = -1;
+    DEV->DSTS = (DEV->DSTS & ~(USB_OTG_DSTS_ENUMSPD_Msk | USB_OTG_DSTS_SUSPSTS)) |
+                _VAL2FLD(USB_OTG_DSTS_ENUMSPD, spd);
+    ep0_in_data1 = false;
+    ep0_out_data1 = false;
+    missed_sof = 0;
+    GLB->GINTSTS |= USB_OTG_GINTSTS_USBRST | USB_OTG_GINTSTS_ENUMDNE;
+}
+
+void otg_model_frame(bool sof) {
+    if (!otg_model_attached()) return;
+    if (sof) {
+        /* (micro)frame number is 14 bit at HS, 11 bit at FS */
+        uint32_t mask = (_FLD2VAL(USB_OTG_DSTS_ENUMSPD, DEV->DSTS) == 0x00) ? 0x3FFF : 0x07FF;
+        uint32_t fn = (_FLD2VAL(USB_OTG_DSTS_FNSOF, DEV->DSTS) + 1) & mask;
+        missed_sof = 0;
+        DEV->DSTS = (DEV->DSTS & ~(USB_OTG_DSTS_FNSOF_Msk | USB_OTG_DSTS_SUSPSTS)) |
+                    _VAL2FLD(USB_OTG_DSTS_FNSOF, fn);
+        GLB->GINTSTS |= USB_OTG_GINTSTS_SOF;
+    } else if (++missed_sof == 3) {
+        DEV->DSTS |= USB_OTG_DSTS_SUSPSTS;
+        GLB->GINTSTS |= USB_OTG_GINTSTS_ESUSP | USB_OTG_GINTSTS_USBSUSP;
+    }
+}
+
+void otg_model_eopf(void) {
+    if (!otg_model_attached()) return;
+    uint32_t odd = frame_odd();
+    for (int ep = 1; ep < core->max_ep; ep++) {
+        uint32_t ctl = epin(ep)->DIEPCTL;
+        if (((ctl & EPCTL_ISO_ARMED) == (EPTYP_ISO | USB_OTG_DIEPCTL_EPENA)) &&
+            (((ctl >> 16) & 0x01) == odd)) {
+            GLB->GINTSTS |= USB_OTG_GINTSTS_IISOIXFR;
+        }
+        ctl = epout(ep)->DOEPCTL;
+        if (((ctl & EPCTL_ISO_ARMED) == (EPTYP_ISO | USB_OTG_DIEPCTL_EPENA)) &&
+            (((ctl >> 16) & 0x01) == odd)) {
+            GLB->GINTSTS |= USB_OTG_GINTSTS_PXFR_INCOMPISOOUT;
+        }
+    }
+}
+
+void otg_model_resume(void) {
+    if (!core) return;
+    missed_sof = 0;
+    DEV->DSTS &= ~USB_OTG_DSTS_SUSPSTS;
+    GLB->GINTSTS |= USB_OTG_GINTSTS_WKUINT;
+}
+
+bool otg_model_rwakeup(void) {
+    if (!core) return false;
+    bool res = rwusig || (DEV->DCTL & USB_OTG_DCTL_RWUSIG);
+    /* L1 resume signaling is timed by core */
+    rwusig = false;
+    DEV->DCTL &= ~USB_OTG_DCTL_RWUSIG;
+    return res;
+}
+
+int otg_model_setup(uint8_t addr, uint8_t ep, const void *pkt) {
+    if (!addressed(addr, ep)) return SIM_NORESP;
+    USB_OTG_OUTEndpointTypeDef *epo = epout(ep);
+    USB_OTG_INEndpointTypeDef *epi = epin(ep);
+    if ((epo->DOEPCTL & USB_OTG_DOEPCTL_EPTYP) || !(epo->DOEPCTL & USB_OTG_DOEPCTL_USBAEP)) {
+        return SIM_NORESP;
+    }
+    /* SETUP is accepted regardless of EPENA and NAK. SETUP packet and SETUP done entries */
+    if (rx_free() < 4) {
+        stats.rx_full++;
+        return SIM_NORESP;
+    }
+    rx_packet(ep | _VAL2FLD(USB_OTG_GRXSTSP_BCNT, 8) |
+              _VAL2FLD(USB_OTG_GRXSTSP_PKTSTS, PKTSTS_SETUP), pkt, 8);
+    rx_packet(ep | _VAL2FLD(USB_OTG_GRXSTSP_PKTSTS, PKTSTS_SETUP_DONE), NULL, 0);
+    uint32_t tsiz = epo->DOEPTSIZ;
+    uint32_t cnt = _FLD2VAL(USB_OTG_DOEPTSIZ_STUPCNT, tsiz);
+    if (cnt) epo->DOEPTSIZ = (tsiz & ~USB_OTG_DOEPTSIZ_STUPCNT_Msk) |
+                             _VAL2FLD(USB_OTG_DOEPTSIZ_STUPCNT, cnt - 1);
+    /* STALL is cleared, both directions are NAKed, data stage starts with DATA1 */
+    epi->DIEPCTL = (epi->DIEPCTL & ~USB_OTG_DIEPCTL_STALL) | USB_OTG_DIEPCTL_NAKSTS;
+    epo->DOEPCTL = (epo->DOEPCTL & ~USB_OTG_DOEPCTL_STALL) | USB_OTG_DOEPCTL_NAKSTS;
+    ep0_in_data1 = true;
+    ep0_out_data1 = true;
+    if (addr != addr_old) addr_old = -1;
+    return SIM_ACK;
+}
+
+int otg_model_out(uint8_t addr, uint8_t ep, bool data1, const void *buf, uint16_t len) {
+    if (!addressed(addr, ep)) return SIM_NORESP;
+    USB_OTG_OUTEndpointTypeDef *epo = epout(ep);
+    uint32_t ctl = epo->DOEPCTL;
+    bool iso = (ctl & USB_OTG_DOEPCTL_EPTYP) == EPTYP_ISO;
+    bool pid = false;
+    if (!(ctl & USB_OTG_DOEPCTL_USBAEP)) return SIM_NORESP;
+    if (ctl & USB_OTG_DOEPCTL_STALL) return iso ? SIM_NORESP : SIM_STALL;
+    if (!(ctl & USB_OTG_DOEPCTL_EPENA) || (ctl & USB_OTG_DOEPCTL_NAKSTS)) {
+        return iso ? SIM_NORESP : SIM_NAK;
+    }
+    /* babble */
+    uint16_t mps = ep_mps(ep, ctl);
+    if (len > mps) return SIM_NORESP;
+    if (iso) {
+        /* armed for the other frame. Packet is dropped */
+        if (((ctl >> 16) & 0x01) != frame_odd()) return SIM_NORESP;
+    } else {
+        pid = (ep == 0) ? ep0_out_data1 : !!(ctl & USB_OTG_DIEPCTL_EONUM_DPID);
+        /* data toggle mismatch. Packet is ACKed and dropped */
+        if (data1 != pid) return SIM_ACK;
+    }
+    uint32_t tsiz = epo->DOEPTSIZ;
+    uint32_t xfr = tsiz & USB_OTG_DOEPTSIZ_XFRSIZ;
+    uint32_t pkt = _FLD2VAL(USB_OTG_DOEPTSIZ_PKTCNT, tsiz);
+    /* transfer completes on the last packet or a short packet */
+    bool done = (pkt <= 1) || (len < mps);
+    if (rx_free() < 1 + FIFO_WORDS(len) + (done ? 1 : 0)) {
+        stats.rx_full++;
+        return iso ? SIM_NORESP : SIM_NAK;
+    }
+    rx_packet(ep | _VAL2FLD(USB_OTG_GRXSTSP_BCNT, len) | (pid ? RXSTS_DATA1 : 0) |
+              _VAL2FLD(USB_OTG_GRXSTSP_PKTSTS, PKTSTS_OUT), buf, len);
+    xfr = (xfr > len) ? xfr - len : 0;
+    if (pkt) pkt--;
+    epo->DOEPTSIZ = (tsiz & ~(USB_OTG_DOEPTSIZ_XFRSIZ | USB_OTG_DOEPTSIZ_PKTCNT)) |
+                    _VAL2FLD(USB_OTG_DOEPTSIZ_PKTCNT, pkt) | xfr;
+    if (ep == 0) {
+        ep0_out_data1 = !pid;
+    } else if (!iso) {
+        ctl ^= USB_OTG_DIEPCTL_EONUM_DPID;
+    }
+    if (done) {
+        /* endpoint is disabled and NAKed until the driver rearms it */
+        ctl = (ctl & ~USB_OTG_DOEPCTL_EPENA) | USB_OTG_DOEPCTL_NAKSTS;
+        rx_packet(ep | _VAL2FLD(USB_OTG_GRXSTSP_PKTSTS, PKTSTS_OUT_DONE), NULL, 0);
+    }
+    epo->DOEPCTL = ctl;
+    return SIM_ACK;
+}
+
+int otg_model_in(uint8_t addr, uint8_t ep, bool *data1, void *buf, uint16_t blen) {
+    if (!addressed(addr, ep)) return SIM_NORESP;
+    USB_OTG_INEndpointTypeDef *epi = epin(ep);
+    uint32_t ctl = epi->DIEPCTL;
+    bool iso = (ctl & USB_OTG_DIEPCTL_EPTYP) == EPTYP_ISO;
+    if (!(ctl & USB_OTG_DIEPCTL_USBAEP)) return SIM_NORESP;
+    if (ctl & USB_OTG_DIEPCTL_STALL) return iso ? SIM_NORESP : SIM_STALL;
+    if (!(ctl & USB_OTG_DIEPCTL_EPENA) || (ctl & USB_OTG_DIEPCTL_NAKSTS)) {
+        return iso ? SIM_NORESP : SIM_NAK;
+    }
+    if (iso && (((ctl >> 16) & 0x01) != frame_odd())) return SIM_NORESP;
+    uint32_t tsiz = epi->DIEPTSIZ;
+    uint32_t xfr = tsiz & USB_OTG_DIEPTSIZ_XFRSIZ;
+    uint32_t pkt = _FLD2VAL(USB_OTG_DIEPTSIZ_PKTCNT, tsiz);
+    if (pkt == 0) return iso ? SIM_NORESP : SIM_NAK;
+    uint16_t len = min16(xfr, ep_mps(ep, ctl));
+    /* packet is not loaded to TX FIFO yet */
+    if (txf[ep].count < FIFO_WORDS(len)) return iso ? SIM_NORESP : SIM_NAK;
+    for (uint16_t n = 0; n < len; n += 4) {
+        uint32_t w = fifo_pop(&txf[ep]);
+        for (int i = 0; (i < 4) && (n + i < len) && (n + i < blen); i++) {
+            ((uint8_t*)buf)[n + i] = w >> (i * 8);
+        }
+    }
+    if (iso) {
+        *data1 = false;
+    } else if (ep == 0) {
+        *data1 = ep0_in_data1;
+        ep0_in_data1 = !ep0_in_data1;
+    } else {
+        *data1 = !!(ctl & USB_OTG_DIEPCTL_EONUM_DPID);
+        ctl ^= USB_OTG_DIEPCTL_EONUM_DPID;
+    }
+    xfr -= len;
+    pkt--;
+    epi->DIEPTSIZ = (tsiz & ~(USB_OTG_DIEPTSIZ_XFRSIZ | USB_OTG_DIEPTSIZ_PKTCNT)) |
+                    _VAL2FLD(USB_OTG_DIEPTSIZ_PKTCNT, pkt) | xfr;
+    if (pkt == 0) {
+        ctl &= ~USB_OTG_DIEPCTL_EPENA;
+        epi->DIEPINT |= USB_OTG_DIEPINT_XFRC;
+        /* status stage of SET_ADDRESS is done */
+        if (ep == 0) addr_old = -1;
+    }
+    epi->DIEPCTL = ctl;
+    return len;
+}
+
+int otg_model_lpm(uint8_t addr, uint16_t attr) {
+    if (!addressed(addr, 0)) return SIM_NORESP;
+    uint32_t cfg = GLB->GLPMCFG;
+    if (!(cfg & USB_OTG_GLPMCFG_LPMEN)) return SIM_STALL;
+    if (!(cfg & USB_OTG_GLPMCFG_LPMACK)) return SIM_NYET;
+    GLB->GLPMCFG = (cfg & ~(USB_OTG_GLPMCFG_BESL_Msk | USB_OTG_GLPMCFG_REMWAKE)) |
+                   _VAL2FLD(USB_OTG_GLPMCFG_BESL, attr >> 4) |
+                   ((attr & 0x100) ? USB_OTG_GLPMCFG_REMWAKE : 0);
+    GLB->GINTSTS |= USB_OTG_GINTSTS_LPMINT;
+    return SIM_ACK;
+}
+
+bool otg_model_fifo_check(void) {
+    uint32_t start[MAX_EP + 1], end[MAX_EP + 1];
+    int n = 0;
+    if (!core) return false;
+    start[n] = 0;
+    end[n++] = GLB->GRXFSIZ & 0xFFFF;
+    for (int ep = 0; ep < core->max_ep; ep++) {
+        if (ep && !(epin(ep)->DIEPCTL & USB_OTG_DIEPCTL_USBAEP)) continue;
+        uint32_t t = ep ? GLB->DIEPTXF[ep - 1] : GLB->DIEPTXF0_HNPTXFSIZ;
+        start[n] = t & 0xFFFF;
+        end[n++] = (t & 0xFFFF) + (t >> 16);
+    }
+    for (int i = 0; i < n; i++) {
+        if (end[i] > core->ram_words) return false;
+        for (int j = 0; j < i; j++) {
+            if ((start[i] < end[j]) && (start[j] < end[i])) return false;
+        }
+    }
+    return true;
+}
+
+void otg_model_preempt(void (*hook)(void)) {
+    preempt = hook;
+}
+
+const struct otg_model_stats *otg_model_stats(void) {
+    return &stats;
+}
+
+const struct sim_port otg_model_port = {
+    .irq        = otg_model_irq,
+    .attached   = otg_model_attached,
+    .reset      = otg_model_reset,
+    .frame      = otg_model_frame,
+    .eopf       = otg_model_eopf,
+    .resume     = otg_model_resume,
+    .rwakeup    = otg_model_rwakeup,
+    .setup      = otg_model_setup,
+    .out        = otg_model_out,
+    .in         = otg_model_in,
+    .lpm        = otg_model_lpm,
+};
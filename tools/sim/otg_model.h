@@ -0,0 +1,148 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _OTG_MODEL_H_
+#define _OTG_MODEL_H_
+#if defined(__cplusplus)
+    extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "sim.h"
+
+/**\addtogroup SIM_OTG OTG device core register model
+ * \brief Host-side model of the Synopsys OTG core in the device mode.
+ * \details Runs the unchanged \ref usbd_otgfs and \ref usbd_otghs drivers on the host. The core
+ * has pop on read registers (GRXSTSP, FIFO), write 1 to clear flags and the self-clearing reset
+ * and flush bits the driver waits for, so the register space is mapped at it's CMSIS base
+ * address without the access rights. Each driver access is trapped, executed by single step and passed to the model.
+ * The model keeps the shared RX FIFO with the status entries, TX FIFO for each IN endpoint with
+ * the space accounting by DTXFSTS, DIEPTSIZ/DOEPTSIZ transfer counters and the interrupt flags.
+ * Requires x86-64 Linux. Only one core is modelled per process. Build example:
+ * \code
+ * cc -Itools/sim -Iinc -DSTM32F4 -DSTM32F429xx src/usbd_core.c src/usbd_stm32_otg.c \
+ *    tools/sim/stm32.c tools/sim/otg_model.c app.c
+ * \endcode
+ * @{ */
+
+/**\brief FIFO usage counters */
+struct otg_model_stats {
+    uint16_t    rx_peak;        /**<\brief RX FIFO high watermark in 32-bit words.*/
+    uint16_t    tx_peak[16];    /**<\brief TX FIFO high watermarks in 32-bit words.*/
+    uint32_t    rx_full;        /**<\brief OUT packets NAKed for the lack of RX FIFO space.*/
+    uint32_t    tx_overrun;     /**<\brief Words written to the full TX FIFO and lost.*/
+    uint32_t    accesses;       /**<\brief Trapped driver register accesses.*/
+};
+
+/**\brief Maps the core register space and resets it to the power-on state
+ * \param hs TRUE for the OTG HS core, FALSE for the OTG FS core
+ * \return FALSE if the family has no such core or the register space can't be mapped
+ */
+bool otg_model_init(bool hs);
+
+/**\brief Checks pending interrupts
+ * \return TRUE if GINTSTS has unmasked interrupt flags. Call \ref usbd_poll while it's TRUE.
+ */
+bool otg_model_irq(void);
+
+/**\brief Checks device attachment
+ * \return TRUE if the core is clocked, the PHY is powered and soft disconnect is released
+ */
+bool otg_model_attached(void);
+
+/**\brief Signals USB bus reset. Enumerates at HS if DCFG_DSPD selects HS. */
+void otg_model_reset(void);
+
+/**\brief Passes one (micro)frame
+ * \param sof TRUE if the host sends SOF. 3 frames without SOF signal SUSPEND.
+ */
+void otg_model_frame(bool sof);
+
+/**\brief End of the periodic frame
+ * \details Flags incomplete isochronous transfers armed for the current frame. Call it before
+ * \ref otg_model_frame.
+ */
+void otg_model_eopf(void);
+
+/**\brief Signals host-initiated resume */
+void otg_model_resume(void);
+
+/**\brief Checks device-initiated resume signaling
+ * \return TRUE if DCTL_RWUSIG was set by the driver since the last check
+ */
+bool otg_model_rwakeup(void);
+
+/**\brief SETUP transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param pkt 8 bytes of the setup packet
+ * \return transaction result
+ */
+int otg_model_setup(uint8_t addr, uint8_t ep, const void *pkt);
+
+/**\brief OUT transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param data1 TRUE for the DATA1 PID
+ * \param buf pointer to the packet data
+ * \param len packet length
+ * \return transaction result
+ */
+int otg_model_out(uint8_t addr, uint8_t ep, bool data1, const void *buf, uint16_t len);
+
+/**\brief IN transaction
+ * \param addr device address
+ * \param ep endpoint number
+ * \param[out] data1 set to TRUE for the DATA1 PID
+ * \param buf pointer to the buffer for the packet data
+ * \param blen buffer size
+ * \return packet length or negative transaction result
+ */
+int otg_model_in(uint8_t addr, uint8_t ep, bool *data1, void *buf, uint16_t blen);
+
+/**\brief LPM extended token
+ * \param addr device address
+ * \param attr bmAttributes of the LPM token. BESL in bits 7:4, bRemoteWake in bit 8.
+ * \return \ref SIM_ACK, \ref SIM_NYET or \ref SIM_STALL if LPM is not enabled
+ */
+int otg_model_lpm(uint8_t addr, uint16_t attr);
+
+/**\brief Checks FIFO layout
+ * \return TRUE if RX FIFO and TX FIFOs of the active IN endpoints fit the FIFO RAM and
+ * don't overlap
+ */
+bool otg_model_fifo_check(void);
+
+/**\brief Sets the interrupt injection hook
+ * \details The hook is called after each trapped register access on the accessing thread, so
+ * the test can run the interrupt handler between the driver instructions of the other thread.
+ * It's called from the signal handler and must not access the registers on the same thread.
+ * \param hook pointer to the hook or NULL
+ */
+void otg_model_preempt(void (*hook)(void));
+
+/**\brief Returns FIFO usage counters collected since \ref otg_model_init */
+const struct otg_model_stats *otg_model_stats(void);
+
+/**\brief Bus side functions of the model for the \ref SIM_HOST */
+extern const struct sim_port otg_model_port;
+
+/** @} */
+
+#if defined(__cplusplus)
+    }
+#endif
+#endif //_OTG_MODEL_H_
@@ -0,0 +1,58 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SIM_H_
+#define _SIM_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/**\addtogroup SIM Host-side simulation
+ * \brief Register models of the USB peripherals for the host builds.
+ * @{ */
+
+/**\name Transaction results
+ * \details Returned by the token functions of the register models.
+ * @{ */
+#define SIM_ACK         0       /**<\brief Transaction completed. Also returned for the isochronous.*/
+#define SIM_NAK         -1      /**<\brief Endpoint NAKed the token.*/
+#define SIM_STALL       -2      /**<\brief Endpoint is stalled.*/
+#define SIM_NORESP      -3      /**<\brief No response. Endpoint or device is disabled, babble.*/
+#define SIM_NYET        -4      /**<\brief LPM transaction is not acknowledged.*/
+/** @} */
+
+/**\brief Bus side of the register model
+ * \details Token and bus state functions of the model in the table form, so the host emulator
+ * (\ref SIM_HOST) can drive any of them. See the model for the function details.
+ */
+struct sim_port {
+    bool    (*irq)(void);           /**<\brief Checks pending interrupts.*/
+    bool    (*attached)(void);      /**<\brief Checks device attachment.*/
+    void    (*reset)(void);         /**<\brief Signals USB bus reset.*/
+    void    (*frame)(bool sof);     /**<\brief Passes one (micro)frame.*/
+    void    (*eopf)(void);          /**<\brief End of the periodic frame. Optional, may be NULL.*/
+    void    (*resume)(void);        /**<\brief Signals host-initiated resume.*/
+    bool    (*rwakeup)(void);       /**<\brief Checks device-initiated resume signaling.*/
+    int     (*setup)(uint8_t addr, uint8_t ep, const void *pkt);  /**<\brief SETUP transaction.*/
+    int     (*out)(uint8_t addr, uint8_t ep, bool data1, const void *buf, uint16_t len);
+                                    /**<\brief OUT transaction.*/
+    int     (*in)(uint8_t addr, uint8_t ep, bool *data1, void *buf, uint16_t blen);
+                                    /**<\brief IN transaction.*/
+    int     (*lpm)(uint8_t addr, uint16_t attr);    /**<\brief LPM extended token.*/
+};
+
+/** @} */
+
+#endif //_SIM_H_
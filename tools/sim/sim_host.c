@@ -0,0 +1,482 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "sim_host.h"
+
+/* Bus timing defaults. Token, handshake and inter-packet delays are in the overhead. */
+#define FS_FRAME_NS     1000000
+#define FS_TOKEN_NS     3000
+#define FS_BYTE_NS      667
+#define HS_FRAME_NS     125000
+#define HS_TOKEN_NS     300
+#define HS_BYTE_NS      17
+#define PID_CRC_SIZE    3
+
+/* USB 2.0 9.2.6 timings in ns */
+#define RESET_RECOVERY  10000000
+#define SETADDR_RECOVERY 2000000
+#define RESUME_RECOVERY 10000000
+
+#define DEFAULT_TIMEOUT 5000
+
+#define EPDIR(ep)       (((ep) >> 7) & 0x01)
+#define EPNUM(ep)       ((ep) & 0x0F)
+#define TOGGLE_BIT(ep)  (1UL << (EPNUM(ep) + (EPDIR(ep) ? 16 : 0)))
+
+/** \brief Passes the frame boundary. Time already spent past it is kept. */
+static void next_frame(struct sim_host *h, bool sof) {
+    if (h->now < h->frame_end) h->now = h->frame_end;
+    h->frame_end += h->frame_ns;
+    h->frame++;
+    if (sof && h->port->eopf) {
+        /* incomplete isochronous transfers are serviced before the next SOF */
+        h->port->eopf();
+        sim_host_poll(h);
+    }
+    h->port->frame(sof);
+    sim_host_poll(h);
+}
+
+/** \brief Advances the bus time by the transaction time */
+static void bus_time(struct sim_host *h, uint32_t len, bool data) {
+    h->now += h->token_ns;
+    if (data) {
+        h->now += (uint64_t)(len + PID_CRC_SIZE) * h->byte_ns;
+    }
+    while (h->now >= h->frame_end) {
+        next_frame(h, true);
+    }
+}
+
+/** \brief Waits on the bus. No transactions in the meantime. */
+static void bus_wait(struct sim_host *h, uint64_t ns) {
+    uint64_t end = h->now + ns;
+    while (h->frame_end <= end) {
+        next_frame(h, true);
+    }
+    if (h->now < end) h->now = end;
+}
+
+static bool toggle(struct sim_host *h, uint8_t ep) {
+    return !!(h->toggle & TOGGLE_BIT(ep));
+}
+
+static void toggle_flip(struct sim_host *h, uint8_t ep) {
+    h->toggle ^= TOGGLE_BIT(ep);
+}
+
+static void toggle_set(struct sim_host *h, uint8_t ep, bool data1) {
+    if (data1) {
+        h->toggle |= TOGGLE_BIT(ep);
+    } else {
+        h->toggle &= ~TOGGLE_BIT(ep);
+    }
+}
+
+static void xfer_start(struct sim_host *h, struct sim_xfer *x, uint8_t type, uint8_t ep) {
+    memset(x, 0, sizeof(*x));
+    x->type = type;
+    x->ep = ep;
+    x->start = h->now;
+    x->polls = h->polls;
+}
+
+static int xfer_done(struct sim_host *h, struct sim_xfer *x, int result) {
+    struct sim_host_stats *s = &h->stats[EPDIR(x->ep)][EPNUM(x->ep)];
+    uint64_t lat;
+    x->result = (result < 0) ? result : SIM_ACK;
+    x->end = h->now;
+    x->polls = h->polls - x->polls;
+    lat = x->end - x->start;
+    if (x->result == SIM_ACK) {
+        if (s->xfers == 0 || lat < s->lat_min) s->lat_min = lat;
+        if (lat > s->lat_max) s->lat_max = lat;
+        s->lat_sum += lat;
+        s->bytes += x->length;
+        s->xfers++;
+    } else {
+        s->errors++;
+    }
+    s->naks += x->naks;
+    if (h->record) {
+        h->record(x, h->arg);
+    }
+    return (result < 0) ? result : (int)x->length;
+}
+
+/** \brief Checks transfer timeout after the NAK.
+ * \param frame_retry TRUE to retry in the next frame, FALSE to retry immediately
+ */
+static bool nak_retry(struct sim_host *h, struct sim_xfer *x, bool frame_retry) {
+    uint64_t timeout = (uint64_t)h->timeout * h->frame_ns;
+    x->naks++;
+    if (h->now - x->start >= timeout) return false;
+    if (frame_retry) {
+        next_frame(h, true);
+    }
+    return true;
+}
+
+/** \brief OUT transaction with NAK retries */
+static int out_packet(struct sim_host *h, struct sim_xfer *x, uint8_t ep,
+                      const void *buf, uint16_t len, bool frame_retry) {
+    int res;
+    do {
+        res = h->port->out(h->addr, EPNUM(ep), toggle(h, ep), buf, len);
+        bus_time(h, len, res != SIM_NORESP);
+        sim_host_poll(h);
+    } while (res == SIM_NAK && nak_retry(h, x, frame_retry));
+    if (res == SIM_ACK) {
+        toggle_flip(h, ep);
+        x->packets++;
+    }
+    return res;
+}
+
+/** \brief IN transaction with NAK retries. Packets with the unexpected toggle are dropped. */
+static int in_packet(struct sim_host *h, struct sim_xfer *x, uint8_t ep,
+                     void *buf, uint16_t len, bool frame_retry) {
+    bool data1;
+    int res;
+    for (;;) {
+        res = h->port->in(h->addr, EPNUM(ep), &data1, buf, len);
+        bus_time(h, (res > 0) ? res : 0, res >= 0);
+        sim_host_poll(h);
+        if (res == SIM_NAK) {
+            if (nak_retry(h, x, frame_retry)) continue;
+            break;
+        }
+        if (res < 0 || data1 == toggle(h, ep)) break;
+    }
+    if (res >= 0) {
+        toggle_flip(h, ep);
+        x->packets++;
+    }
+    return res;
+}
+
+void sim_host_init(struct sim_host *h, const struct sim_port *port, usbd_device *dev, bool hs) {
+    memset(h, 0, sizeof(*h));
+    h->port = port;
+    h->dev = dev;
+    h->frame_ns = hs ? HS_FRAME_NS : FS_FRAME_NS;
+    h->token_ns = hs ? HS_TOKEN_NS : FS_TOKEN_NS;
+    h->byte_ns = hs ? HS_BYTE_NS : FS_BYTE_NS;
+    h->timeout = hs ? 8 * DEFAULT_TIMEOUT : DEFAULT_TIMEOUT;
+    h->frame_end = h->frame_ns;
+    h->mps[0][0] = h->mps[1][0] = 8;
+    sim_host_poll(h);
+}
+
+/** \brief Host time in ns */
+static uint64_t host_time(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void sim_host_poll(struct sim_host *h) {
+    for (int n = 0; n < SIM_HOST_POLL_MAX && h->port->irq(); n++) {
+        uint64_t _t;
+        if (h->poll_ns == SIM_HOST_POLL_MEASURE) {
+            _t = host_time();
+            usbd_poll(h->dev);
+            _t = host_time() - _t;
+        } else {
+            usbd_poll(h->dev);
+            _t = h->poll_ns;
+        }
+        h->now += _t;
+        h->poll_time += _t;
+        h->polls++;
+    }
+}
+
+void sim_host_frames(struct sim_host *h, uint32_t count, bool sof) {
+    while (count--) {
+        next_frame(h, sof);
+    }
+}
+
+int sim_host_reset(struct sim_host *h) {
+    for (uint32_t i = 0; !h->port->attached(); i++) {
+        if (i >= h->timeout) return SIM_NORESP;
+        next_frame(h, false);
+    }
+    h->port->reset();
+    sim_host_poll(h);
+    h->addr = 0;
+    h->toggle = 0;
+    memset(h->type, 0, sizeof(h->type));
+    memset(h->mps, 0, sizeof(h->mps));
+    h->mps[0][0] = h->mps[1][0] = 8;
+    bus_wait(h, RESET_RECOVERY);
+    return SIM_ACK;
+}
+
+void sim_host_resume(struct sim_host *h) {
+    h->port->resume();
+    sim_host_poll(h);
+    bus_wait(h, RESUME_RECOVERY);
+}
+
+/** \brief Takes endpoint types and sizes from the configuration descriptor
+ * \param configured FALSE to deconfigure all endpoints except control
+ */
+static void parse_config(struct sim_host *h, bool configured) {
+    const uint16_t mps0 = h->mps[0][0];
+    memset(h->type, 0, sizeof(h->type));
+    memset(h->mps, 0, sizeof(h->mps));
+    h->mps[0][0] = h->mps[1][0] = mps0;
+    if (!configured) return;
+    for (uint16_t pos = 0; pos + 2 <= h->config_len; ) {
+        const struct usb_endpoint_descriptor *d = (const void*)&h->config[pos];
+        if (d->bLength < 2 || pos + d->bLength > h->config_len) break;
+        if (d->bDescriptorType == USB_DTYPE_ENDPOINT && d->bLength >= sizeof(*d) &&
+            EPNUM(d->bEndpointAddress) != 0) {
+            uint8_t ep = d->bEndpointAddress;
+            h->type[EPDIR(ep)][EPNUM(ep)] = d->bmAttributes & 0x03;
+            h->mps[EPDIR(ep)][EPNUM(ep)] = d->wMaxPacketSize & 0x07FF;
+        }
+        pos += d->bLength;
+    }
+}
+
+/** \brief Tracks the device state changed by the standard request */
+static void std_request(struct sim_host *h, const usbd_ctlreq *req) {
+    if ((req->bmRequestType & USB_REQ_TYPE) != USB_REQ_STANDARD) return;
+    switch (req->bRequest) {
+    case USB_STD_SET_ADDRESS:
+        h->addr = req->wValue & 0x7F;
+        bus_wait(h, SETADDR_RECOVERY);
+        break;
+    case USB_STD_SET_CONFIG:
+        parse_config(h, req->wValue != 0);
+        /* fallthrough */
+    case USB_STD_SET_INTERFACE:
+        /* data endpoints start with DATA0 */
+        h->toggle &= TOGGLE_BIT(0x00) | TOGGLE_BIT(0x80);
+        break;
+    case USB_STD_CLEAR_FEATURE:
+        if ((req->bmRequestType & USB_REQ_RECIPIENT) == USB_REQ_ENDPOINT &&
+            req->wValue == USB_FEAT_ENDPOINT_HALT) {
+            toggle_set(h, req->wIndex, false);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+int sim_host_control(struct sim_host *h, uint8_t bmRequestType, uint8_t bRequest,
+                     uint16_t wValue, uint16_t wIndex, void *data, uint16_t wLength) {
+    const usbd_ctlreq req = {
+        .bmRequestType  = bmRequestType,
+        .bRequest       = bRequest,
+        .wValue         = wValue,
+        .wIndex         = wIndex,
+        .wLength        = wLength,
+    };
+    const bool dir_in = (bmRequestType & USB_REQ_DIRECTION) == USB_REQ_DEVTOHOST;
+    uint8_t *buf = data;
+    struct sim_xfer x;
+    uint32_t pos = 0;
+    int res;
+
+    xfer_start(h, &x, USB_EPTYPE_CONTROL, 0x00);
+    /* SETUP stage */
+    res = h->port->setup(h->addr, 0, &req);
+    bus_time(h, 8, true);
+    sim_host_poll(h);
+    if (res != SIM_ACK) return xfer_done(h, &x, res);
+    toggle_set(h, 0x00, true);
+    toggle_set(h, 0x80, true);
+    /* DATA stage */
+    while (pos < wLength) {
+        uint16_t _t = wLength - pos;
+        if (_t > h->mps[dir_in][0]) _t = h->mps[dir_in][0];
+        if (dir_in) {
+            res = in_packet(h, &x, 0x80, &buf[pos], _t, false);
+            if (res < 0) return xfer_done(h, &x, res);
+            pos += res;
+            if (res < h->mps[1][0]) break;
+        } else {
+            res = out_packet(h, &x, 0x00, &buf[pos], _t, false);
+            if (res < 0) return xfer_done(h, &x, res);
+            pos += _t;
+        }
+    }
+    x.length = pos;
+    /* STATUS stage is always DATA1 */
+    toggle_set(h, 0x00, true);
+    toggle_set(h, 0x80, true);
+    if (dir_in && wLength) {
+        res = out_packet(h, &x, 0x00, NULL, 0, false);
+    } else {
+        uint8_t zlp[1];
+        res = in_packet(h, &x, 0x80, zlp, 0, false);
+    }
+    if (res < 0) return xfer_done(h, &x, res);
+    x.packets--;
+    res = xfer_done(h, &x, SIM_ACK);
+    std_request(h, &req);
+    return res;
+}
+
+/** \brief Reads descriptor */
+static int get_descr(struct sim_host *h, uint8_t dtype, uint8_t idx, uint16_t lang,
+                     void *buf, uint16_t len) {
+    return sim_host_control(h, USB_REQ_DEVTOHOST | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                            USB_STD_GET_DESCRIPTOR, (dtype << 8) | idx, lang, buf, len);
+}
+
+int sim_host_probe(struct sim_host *h, uint8_t addr) {
+    const struct usb_config_descriptor *cfg = (const void*)h->config;
+    uint8_t str[0xFF];
+    uint16_t lang = 0;
+    int res;
+
+    res = sim_host_reset(h);
+    if (res < 0) return res;
+    /* device descriptor header to learn the EP0 size */
+    res = get_descr(h, USB_DTYPE_DEVICE, 0, 0, &h->device, 8);
+    if (res < 0) return res;
+    if (res < 8) return SIM_NORESP;
+    h->mps[0][0] = h->mps[1][0] = h->device.bMaxPacketSize0;
+    res = sim_host_control(h, USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                           USB_STD_SET_ADDRESS, addr, 0, NULL, 0);
+    if (res < 0) return res;
+    res = get_descr(h, USB_DTYPE_DEVICE, 0, 0, &h->device, sizeof(h->device));
+    if (res < 0) return res;
+    if (res < (int)sizeof(h->device)) return SIM_NORESP;
+    /* configuration header, then whole configuration */
+    res = get_descr(h, USB_DTYPE_CONFIGURATION, 0, 0, h->config, sizeof(*cfg));
+    if (res < 0) return res;
+    if (res < (int)sizeof(*cfg)) return SIM_NORESP;
+    h->config_len = (cfg->wTotalLength < sizeof(h->config)) ? cfg->wTotalLength
+                                                            : sizeof(h->config);
+    res = get_descr(h, USB_DTYPE_CONFIGURATION, 0, 0, h->config, h->config_len);
+    if (res < 0) return res;
+    h->config_len = res;
+    /* strings */
+    const uint8_t sidx[] = {h->device.iManufacturer, h->device.iProduct,
+                            h->device.iSerialNumber, cfg->iConfiguration};
+    if (sidx[0] || sidx[1] || sidx[2] || sidx[3]) {
+        res = get_descr(h, USB_DTYPE_STRING, 0, 0, str, sizeof(str));
+        if (res < 0) return res;
+        if (res >= 4) lang = str[2] | (str[3] << 8);
+        for (unsigned i = 0; i < sizeof(sidx); i++) {
+            if (sidx[i] == 0) continue;
+            res = get_descr(h, USB_DTYPE_STRING, sidx[i], lang, str, sizeof(str));
+            if (res < 0) return res;
+        }
+    }
+    return SIM_ACK;
+}
+
+int sim_host_enumerate(struct sim_host *h, uint8_t addr) {
+    const struct usb_config_descriptor *cfg = (const void*)h->config;
+    const uint64_t start = h->now;
+    int res = sim_host_probe(h, addr);
+    if (res < 0) return res;
+    res = sim_host_control(h, USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                           USB_STD_SET_CONFIG, cfg->bConfigurationValue, 0, NULL, 0);
+    if (res < 0) return res;
+    h->enum_time = h->now - start;
+    return SIM_ACK;
+}
+
+int sim_host_write(struct sim_host *h, uint8_t ep, const void *data, uint32_t len, bool zlp) {
+    const uint8_t *buf = data;
+    const uint8_t type = h->type[0][EPNUM(ep)];
+    const uint16_t mps = h->mps[0][EPNUM(ep)];
+    struct sim_xfer x;
+    uint32_t pos = 0;
+    int res;
+
+    ep &= 0x0F;
+    xfer_start(h, &x, type, ep);
+    if (mps == 0) return xfer_done(h, &x, SIM_NORESP);
+    do {
+        uint16_t _t = ((len - pos) < mps) ? (len - pos) : mps;
+        res = out_packet(h, &x, ep, &buf[pos], _t, type == USB_EPTYPE_INTERRUPT);
+        if (res < 0) return xfer_done(h, &x, res);
+        pos += _t;
+        if (_t < mps) break;
+    } while (pos < len || zlp);
+    x.length = pos;
+    return xfer_done(h, &x, SIM_ACK);
+}
+
+int sim_host_read(struct sim_host *h, uint8_t ep, void *data, uint32_t len) {
+    uint8_t *buf = data;
+    const uint8_t type = h->type[1][EPNUM(ep)];
+    const uint16_t mps = h->mps[1][EPNUM(ep)];
+    struct sim_xfer x;
+    uint32_t pos = 0;
+    int res;
+
+    ep |= 0x80;
+    xfer_start(h, &x, type, ep);
+    if (mps == 0) return xfer_done(h, &x, SIM_NORESP);
+    while (pos < len) {
+        uint16_t _t = ((len - pos) < mps) ? (len - pos) : mps;
+        res = in_packet(h, &x, ep, &buf[pos], _t, type == USB_EPTYPE_INTERRUPT);
+        if (res < 0) return xfer_done(h, &x, res);
+        pos += res;
+        if (res < mps) break;
+    }
+    x.length = pos;
+    return xfer_done(h, &x, SIM_ACK);
+}
+
+int sim_host_iso_write(struct sim_host *h, uint8_t ep, const void *data, uint16_t len) {
+    struct sim_xfer x;
+    int res;
+    ep &= 0x0F;
+    next_frame(h, true);
+    xfer_start(h, &x, USB_EPTYPE_ISOCHRONUS, ep);
+    res = h->port->out(h->addr, ep, false, data, len);
+    bus_time(h, len, true);
+    sim_host_poll(h);
+    if (res < 0) return xfer_done(h, &x, res);
+    x.packets = 1;
+    x.length = len;
+    return xfer_done(h, &x, SIM_ACK);
+}
+
+int sim_host_iso_read(struct sim_host *h, uint8_t ep, void *data, uint16_t len) {
+    struct sim_xfer x;
+    bool data1;
+    int res;
+    ep |= 0x80;
+    next_frame(h, true);
+    xfer_start(h, &x, USB_EPTYPE_ISOCHRONUS, ep);
+    res = h->port->in(h->addr, EPNUM(ep), &data1, data, len);
+    bus_time(h, (res > 0) ? res : 0, res >= 0);
+    sim_host_poll(h);
+    if (res < 0) return xfer_done(h, &x, SIM_NORESP);
+    x.packets = 1;
+    x.length = res;
+    return xfer_done(h, &x, SIM_ACK);
+}
+
+void sim_host_clear_stats(struct sim_host *h) {
+    memset(h->stats, 0, sizeof(h->stats));
+}
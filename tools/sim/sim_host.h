@@ -0,0 +1,234 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SIM_HOST_H_
+#define _SIM_HOST_H_
+#if defined(__cplusplus)
+    extern "C" {
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "usb.h"
+#include "sim.h"
+
+/**\addtogroup SIM_HOST USB host emulator
+ * \brief Host side of the bus for the register models.
+ * \details Drives the device stack through the \ref sim_port of the register model and plays
+ * the host role: bus reset, enumeration, control, bulk, interrupt and isochronous transfers.
+ * Each call completes the whole transfer and services the device interrupts by \ref usbd_poll
+ * after each transaction, so the test script is the plain C code.
+ *
+ * The bus time is simulated. Each transaction takes \ref sim_host::token_ns plus
+ * \ref sim_host::byte_ns for each byte of the data packet, frame boundaries are passed to the
+ * model when the time crosses them. Each \ref usbd_poll call is charged \ref sim_host::poll_ns
+ * of device time, the bus is idle meanwhile. It's 0 by default, so the device is infinitely
+ * fast and the results depend only on its handshakes. \ref SIM_HOST_POLL_MEASURE charges the
+ * host time of the call instead, this includes the register model overhead and is not
+ * reproducible between the runs. The OTG model traps each register access, so its time is
+ * dominated by the access count.
+ * NAKed bulk and control transactions are retried immediately, interrupt and isochronous ones
+ * in the next frame. Every completed transfer is recorded as \ref sim_xfer and accumulated to
+ * the \ref sim_host_stats of the endpoint.
+ * \code
+ * struct sim_host host;
+ * devfs_model_init();
+ * usbd_init(&udev, &usbd_hw, 8, buf, sizeof(buf));
+ * ...
+ * usbd_enable(&udev, true);
+ * usbd_connect(&udev, true);
+ * sim_host_init(&host, &devfs_model_port, &udev, false);
+ * if (sim_host_enumerate(&host, 1) < 0) return 1;
+ * sim_host_write(&host, 0x01, data, sizeof(data), false);
+ * sim_host_read(&host, 0x81, data, sizeof(data));
+ * \endcode
+ * @{ */
+
+#if !defined(SIM_HOST_CFG_SIZE)
+#define SIM_HOST_CFG_SIZE   0x200   /**<\brief Buffer size for the configuration descriptor.*/
+#endif
+#define SIM_HOST_POLL_MAX   0x100   /**<\brief \ref usbd_poll limit for one interrupt service.*/
+#define SIM_HOST_POLL_MEASURE 0xFFFFFFFF /**<\brief \ref sim_host::poll_ns value to charge the
+                                           * measured host time of \ref usbd_poll.*/
+
+/**\brief Completed transfer record */
+struct sim_xfer {
+    uint8_t     type;       /**<\brief Transfer type, USB_EPTYPE_* value.*/
+    uint8_t     ep;         /**<\brief Endpoint address. 0 for the control transfers.*/
+    int         result;     /**<\brief \ref SIM_ACK or the transaction result caused failure.*/
+    uint32_t    length;     /**<\brief Bytes transferred in the data stage.*/
+    uint32_t    packets;    /**<\brief Data packets transferred.*/
+    uint32_t    naks;       /**<\brief NAKed transactions.*/
+    uint32_t    polls;      /**<\brief \ref usbd_poll calls made during the transfer.*/
+    uint64_t    start;      /**<\brief Bus time of the transfer start in ns.*/
+    uint64_t    end;        /**<\brief Bus time of the transfer end in ns.*/
+};
+
+/**\brief Per-endpoint transfer statistics */
+struct sim_host_stats {
+    uint32_t    xfers;      /**<\brief Completed transfers.*/
+    uint32_t    errors;     /**<\brief Failed transfers.*/
+    uint32_t    naks;       /**<\brief NAKed transactions.*/
+    uint64_t    bytes;      /**<\brief Bytes transferred.*/
+    uint64_t    lat_min;    /**<\brief Minimal transfer latency in ns.*/
+    uint64_t    lat_max;    /**<\brief Maximal transfer latency in ns.*/
+    uint64_t    lat_sum;    /**<\brief Sum of the transfer latencies in ns.*/
+};
+
+/**\brief Transfer record callback
+ * \param xfer completed transfer
+ * \param arg \ref sim_host::arg value
+ */
+typedef void (*sim_host_callback)(const struct sim_xfer *xfer, void *arg);
+
+/**\brief Host emulator state
+ * \details Timing fields are set by \ref sim_host_init and may be changed by the script at any
+ * time.
+ */
+struct sim_host {
+    const struct sim_port  *port;           /**<\brief Register model bus side.*/
+    usbd_device            *dev;            /**<\brief Device serviced after each transaction.*/
+    uint32_t                frame_ns;       /**<\brief (Micro)frame length in ns.*/
+    uint32_t                token_ns;       /**<\brief Transaction overhead in ns.*/
+    uint32_t                byte_ns;        /**<\brief Data byte transfer time in ns.*/
+    uint32_t                poll_ns;        /**<\brief Device time of the \ref usbd_poll call in
+                                             * ns or \ref SIM_HOST_POLL_MEASURE.*/
+    uint32_t                timeout;        /**<\brief Transfer timeout in frames.*/
+    uint64_t                now;            /**<\brief Current bus time in ns.*/
+    uint64_t                frame_end;      /**<\brief End of the current frame in ns.*/
+    uint32_t                frame;          /**<\brief Current frame number.*/
+    uint32_t                polls;          /**<\brief Total \ref usbd_poll calls.*/
+    uint64_t                poll_time;      /**<\brief Total device time of the \ref usbd_poll
+                                             * calls in ns.*/
+    uint32_t                toggle;         /**<\brief Data toggles, OUT in bits 15:0, IN in 31:16.*/
+    uint8_t                 addr;           /**<\brief Current device address.*/
+    uint8_t                 type[2][16];    /**<\brief Endpoint types [in][ep] from descriptors.*/
+    uint16_t                mps[2][16];     /**<\brief Endpoint sizes [in][ep] from descriptors.*/
+    uint64_t                enum_time;      /**<\brief Last enumeration time in ns.*/
+    struct usb_device_descriptor    device; /**<\brief Device descriptor.*/
+    uint16_t                config_len;     /**<\brief Configuration descriptor length.*/
+    uint8_t                 config[SIM_HOST_CFG_SIZE];  /**<\brief Configuration descriptor.*/
+    sim_host_callback       record;         /**<\brief Transfer record callback or NULL.*/
+    void                   *arg;            /**<\brief Transfer record callback argument.*/
+    struct sim_host_stats   stats[2][16];   /**<\brief Statistics [in][ep]. Control in [0][0].*/
+};
+
+/**\brief Initializes host emulator
+ * \param host pointer to the host emulator state
+ * \param port bus side of the register model
+ * \param dev pointer to the device
+ * \param hs TRUE for the high-speed bus timing, FALSE for the full-speed
+ */
+void sim_host_init(struct sim_host *host, const struct sim_port *port, usbd_device *dev, bool hs);
+
+/**\brief Services pending device interrupts */
+void sim_host_poll(struct sim_host *host);
+
+/**\brief Passes frames
+ * \param host pointer to the host emulator state
+ * \param count number of frames to pass. The current frame is completed first.
+ * \param sof TRUE to send SOFs, FALSE to let the device suspend
+ */
+void sim_host_frames(struct sim_host *host, uint32_t count, bool sof);
+
+/**\brief Waits for the device attachment and resets the bus
+ * \return \ref SIM_ACK or \ref SIM_NORESP if the device isn't attached within timeout
+ */
+int sim_host_reset(struct sim_host *host);
+
+/**\brief Signals resume and passes the resume recovery time */
+void sim_host_resume(struct sim_host *host);
+
+/**\brief Control transfer on the endpoint 0
+ * \details Tracks the device address and endpoint toggles on the successful SET_ADDRESS,
+ * SET_CONFIGURATION, SET_INTERFACE and CLEAR_FEATURE(ENDPOINT_HALT) requests. Endpoint types
+ * and sizes are taken from the configuration descriptor on the SET_CONFIGURATION.
+ * \param host pointer to the host emulator state
+ * \param bmRequestType request type
+ * \param bRequest request
+ * \param wValue request value
+ * \param wIndex request index
+ * \param data pointer to the data stage buffer
+ * \param wLength data stage length
+ * \return data stage length or negative transaction result
+ */
+int sim_host_control(struct sim_host *host, uint8_t bmRequestType, uint8_t bRequest,
+                     uint16_t wValue, uint16_t wIndex, void *data, uint16_t wLength);
+
+/**\brief Probes the device
+ * \details Resets the bus, reads the device descriptor, assigns address, reads device,
+ * first configuration and string descriptors. Device is left in the addressed state.
+ * \param host pointer to the host emulator state
+ * \param addr device address to assign
+ * \return \ref SIM_ACK or negative transaction result
+ */
+int sim_host_probe(struct sim_host *host, uint8_t addr);
+
+/**\brief Enumerates the device
+ * \details \ref sim_host_probe followed by the SET_CONFIGURATION for the first configuration.
+ * Time is saved to \ref sim_host::enum_time.
+ * \param host pointer to the host emulator state
+ * \param addr device address to assign
+ * \return \ref SIM_ACK or negative transaction result
+ */
+int sim_host_enumerate(struct sim_host *host, uint8_t addr);
+
+/**\brief Bulk or interrupt OUT transfer
+ * \param host pointer to the host emulator state
+ * \param ep endpoint address
+ * \param data pointer to the data
+ * \param len data length
+ * \param zlp TRUE to terminate the transfer by ZLP if the length is multiple of the endpoint size
+ * \return transferred length or negative transaction result
+ */
+int sim_host_write(struct sim_host *host, uint8_t ep, const void *data, uint32_t len, bool zlp);
+
+/**\brief Bulk or interrupt IN transfer
+ * \details Completes on the short packet or when the buffer is full.
+ * \param host pointer to the host emulator state
+ * \param ep endpoint address
+ * \param data pointer to the buffer
+ * \param len buffer size
+ * \return received length or negative transaction result
+ */
+int sim_host_read(struct sim_host *host, uint8_t ep, void *data, uint32_t len);
+
+/**\brief Isochronous OUT packet in the next frame
+ * \param host pointer to the host emulator state
+ * \param ep endpoint address
+ * \param data pointer to the data
+ * \param len packet length
+ * \return packet length or negative transaction result
+ */
+int sim_host_iso_write(struct sim_host *host, uint8_t ep, const void *data, uint16_t len);
+
+/**\brief Isochronous IN packet in the next frame
+ * \param host pointer to the host emulator state
+ * \param ep endpoint address
+ * \param data pointer to the buffer
+ * \param len buffer size
+ * \return packet length or \ref SIM_NORESP if the device has no data for this frame
+ */
+int sim_host_iso_read(struct sim_host *host, uint8_t ep, void *data, uint16_t len);
+
+/**\brief Clears transfer statistics */
+void sim_host_clear_stats(struct sim_host *host);
+
+/** @} */
+
+#if defined(__cplusplus)
+    }
+#endif
+#endif //_SIM_HOST_H_
@@ -0,0 +1,50 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _SIM_MODEL_H_
+#define _SIM_MODEL_H_
+
+#include "usb.h"
+
+/**\addtogroup SIM
+ * @{ */
+
+/**\name Register model selected by the family macros
+ * \details Model of the peripheral used by \ref usbd_hw. SIM_MODEL_INIT() returns FALSE if the
+ * model can't be initialized. SIM_MODEL_OTG is defined for the OTG core model.
+ * @{ */
+#if defined(USBD_STM32L476) || defined(USBD_STM32F429FS) || defined(USBD_STM32F446FS) || \
+    defined(USBD_STM32F105) || defined(USBD_STM32H743FS)
+    #include "otg_model.h"
+    #define SIM_MODEL_OTG
+    #define SIM_MODEL_PORT      otg_model_port
+    #if defined(USBD_PRIMARY_OTGHS)
+    #define SIM_MODEL_INIT()    otg_model_init(true)
+    #define SIM_MODEL_NAME      "otghs"
+    #else
+    #define SIM_MODEL_INIT()    otg_model_init(false)
+    #define SIM_MODEL_NAME      "otgfs"
+    #endif
+#else
+    #include "devfs_model.h"
+    #define SIM_MODEL_PORT      devfs_model_port
+    #define SIM_MODEL_INIT()    (devfs_model_init(), true)
+    #define SIM_MODEL_NAME      "devfs"
+#endif
+/** @} */
+
+/** @} */
+
+#endif //_SIM_MODEL_H_
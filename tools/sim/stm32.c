@@ -0,0 +1,28 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include "stm32.h"
+
+/* Host memory of the peripherals declared in stm32.h */
+RCC_TypeDef     sim_rcc;
+SYSCFG_TypeDef  sim_syscfg;
+PWR_TypeDef     sim_pwr;
+USB_TypeDef     sim_usb;
+uint16_t        sim_pma[0x400];
+uint32_t        sim_uid[8] = {
+    0x00430021, 0x31385114, 0x38323436, 0x00000000,
+    0x00000000, 0x20373930, 0x00000000, 0x00000000,
+};
@@ -0,0 +1,465 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* Host build replacement of the CMSIS device header.
+ * Peripherals used by the drivers are mapped to the host memory of the register models.
+ * Put this directory in front of the include path and define the family macros as for the
+ * target build, i.e. -Itools/sim -Iinc -DSTM32L0 -DSTM32L052xx
+ */
+
+#ifndef _SIM_STM32_H_
+#define _SIM_STM32_H_
+
+#include <stdint.h>
+
+#define __IO                    volatile
+
+/* modify bitfield */
+#define _BMD(reg, msk, val)     (reg) = (((reg) & ~(msk)) | (val))
+/* set bitfield */
+#define _BST(reg, bits)         (reg) = ((reg) | (bits))
+/* clear bitfield */
+#define _BCL(reg, bits)         (reg) = ((reg) & ~(bits))
+/* wait until bitfield set */
+#define _WBS(reg, bits)         while(((reg) & (bits)) == 0)
+/* wait until bitfield clear */
+#define _WBC(reg, bits)         while(((reg) & (bits)) != 0)
+/* wait for bitfield value */
+#define _WVL(reg, msk, val)     while(((reg) & (msk)) != (val))
+/* bit value */
+#define _BV(bit)                (0x01 << (bit))
+
+/* CMSIS bitfield helpers */
+#define _VAL2FLD(field, value)  (((uint32_t)(value) << field ## _Pos) & field ## _Msk)
+#define _FLD2VAL(field, value)  (((uint32_t)(value) & field ## _Msk) >> field ## _Pos)
+
+/* RCC. Superset of the registers used by the drivers */
+typedef struct {
+    __IO uint32_t   AHBENR;
+    __IO uint32_t   AHBRSTR;
+    __IO uint32_t   AHB1ENR;
+    __IO uint32_t   AHB2ENR;
+    __IO uint32_t   AHB1RSTR;
+    __IO uint32_t   AHB2RSTR;
+    __IO uint32_t   AHB1LPENR;
+    __IO uint32_t   APB1ENR;
+    __IO uint32_t   APB1RSTR;
+    __IO uint32_t   APB1ENR1;
+    __IO uint32_t   APB1RSTR1;
+    __IO uint32_t   APB2ENR;
+} RCC_TypeDef;
+
+typedef struct {
+    __IO uint32_t   CFGR1;
+    __IO uint32_t   PMC;
+} SYSCFG_TypeDef;
+
+typedef struct {
+    __IO uint32_t   CR1;
+    __IO uint32_t   CR2;
+} PWR_TypeDef;
+
+/* USB FS device */
+typedef struct {
+    __IO uint16_t   EP0R;
+    uint16_t        RESERVED0;
+    __IO uint16_t   EP1R;
+    uint16_t        RESERVED1;
+    __IO uint16_t   EP2R;
+    uint16_t        RESERVED2;
+    __IO uint16_t   EP3R;
+    uint16_t        RESERVED3;
+    __IO uint16_t   EP4R;
+    uint16_t        RESERVED4;
+    __IO uint16_t   EP5R;
+    uint16_t        RESERVED5;
+    __IO uint16_t   EP6R;
+    uint16_t        RESERVED6;
+    __IO uint16_t   EP7R;
+    uint16_t        RESERVED7[17];
+    __IO uint16_t   CNTR;
+    uint16_t        RESERVED8;
+    __IO uint16_t   ISTR;
+    uint16_t        RESERVED9;
+    __IO uint16_t   FNR;
+    uint16_t        RESERVEDA;
+    __IO uint16_t   DADDR;
+    uint16_t        RESERVEDB;
+    __IO uint16_t   BTABLE;
+    uint16_t        RESERVEDC;
+    __IO uint16_t   LPMCSR;
+    uint16_t        RESERVEDD;
+    __IO uint16_t   BCDR;
+    uint16_t        RESERVEDE;
+} USB_TypeDef;
+
+/* Peripheral storage. Defined in stm32.c */
+extern RCC_TypeDef      sim_rcc;
+extern SYSCFG_TypeDef   sim_syscfg;
+extern PWR_TypeDef      sim_pwr;
+extern USB_TypeDef      sim_usb;
+extern uint16_t         sim_pma[0x400];
+extern uint32_t         sim_uid[8];
+
+#define RCC             (&sim_rcc)
+#define SYSCFG          (&sim_syscfg)
+#define PWR             (&sim_pwr)
+#define USB_BASE        ((uintptr_t)&sim_usb)
+#define USB_PMAADDR     ((uintptr_t)sim_pma)
+#define USB1_BASE       USB_BASE
+#define USB1_PMAADDR    USB_PMAADDR
+#define USB             ((USB_TypeDef*)USB_BASE)
+#define UID_BASE        ((uintptr_t)sim_uid)
+
+/* EPnR writes are routed to the register model */
+void devfs_model_epr_write(volatile uint16_t *epr, uint16_t val);
+#define DEVFS_EPR_WRITE(epr, val)   devfs_model_epr_write((epr), (val))
+
+#define RCC_APB1ENR_USBEN           (1U << 23)
+#define RCC_APB1RSTR_USBRST         (1U << 23)
+#define RCC_APB1ENR1_USBFSEN        (1U << 26)
+#define RCC_APB1RSTR1_USBFSRST      (1U << 26)
+#define RCC_APB2ENR_SYSCFGEN        (1U << 0)
+#define RCC_APB2ENR_SYSCFGCOMPEN    (1U << 0)
+#define SYSCFG_PMC_USB_PU           (1U << 0)
+#define SYSCFG_CFGR1_PA11_PA12_RMP  (1U << 4)
+#define PWR_CR2_USV                 (1U << 10)
+
+#define RCC_AHBENR_OTGFSEN          (1U << 12)
+#define RCC_AHBRSTR_OTGFSRST        (1U << 12)
+#define RCC_AHB2ENR_OTGFSEN         (1U << 7)
+#define RCC_AHB2RSTR_OTGFSRST       (1U << 7)
+#define RCC_AHB1ENR_OTGHSEN         (1U << 29)
+#define RCC_AHB1ENR_OTGHSULPIEN     (1U << 30)
+#define RCC_AHB1RSTR_OTGHRST        (1U << 29)
+#define RCC_AHB1LPENR_OTGHSLPEN     (1U << 29)
+#define RCC_AHB1LPENR_OTGHSULPILPEN (1U << 30)
+#define RCC_AHB1ENR_USB2OTGFSEN     (1U << 27)
+#define RCC_AHB1RSTR_USB2OTGFSRST   (1U << 27)
+
+#define USB_EP0R                    USB_BASE
+
+#define USB_EP_CTR_RX               0x8000
+#define USB_EP_DTOG_RX              0x4000
+#define USB_EPRX_STAT               0x3000
+#define USB_EP_SETUP                0x0800
+#define USB_EP_T_FIELD              0x0600
+#define USB_EP_KIND                 0x0100
+#define USB_EP_CTR_TX               0x0080
+#define USB_EP_DTOG_TX              0x0040
+#define USB_EPTX_STAT               0x0030
+#define USB_EPADDR_FIELD            0x000F
+#define USB_EPREG_MASK              (USB_EP_CTR_RX | USB_EP_SETUP | USB_EP_T_FIELD | \
+                                     USB_EP_KIND | USB_EP_CTR_TX | USB_EPADDR_FIELD)
+
+#define USB_EP_BULK                 0x0000
+#define USB_EP_CONTROL              0x0200
+#define USB_EP_ISOCHRONOUS          0x0400
+#define USB_EP_INTERRUPT            0x0600
+
+#define USB_EP_TX_DIS               0x0000
+#define USB_EP_TX_STALL             0x0010
+#define USB_EP_TX_NAK               0x0020
+#define USB_EP_TX_VALID             0x0030
+#define USB_EP_RX_DIS               0x0000
+#define USB_EP_RX_STALL             0x1000
+#define USB_EP_RX_NAK               0x2000
+#define USB_EP_RX_VALID             0x3000
+
+#define USB_CNTR_CTRM               0x8000
+#define USB_CNTR_PMAOVRM            0x4000
+#define USB_CNTR_ERRM               0x2000
+#define USB_CNTR_WKUPM              0x1000
+#define USB_CNTR_SUSPM              0x0800
+#define USB_CNTR_RESETM             0x0400
+#define USB_CNTR_SOFM               0x0200
+#define USB_CNTR_ESOFM              0x0100
+#define USB_CNTR_L1REQM             0x0080
+#define USB_CNTR_L1RESUME           0x0020
+#define USB_CNTR_RESUME             0x0010
+#define USB_CNTR_FSUSP              0x0008
+#define USB_CNTR_LPMODE             0x0004
+#define USB_CNTR_PDWN               0x0002
+#define USB_CNTR_FRES               0x0001
+
+#define USB_ISTR_CTR                0x8000
+#define USB_ISTR_PMAOVR             0x4000
+#define USB_ISTR_ERR                0x2000
+#define USB_ISTR_WKUP               0x1000
+#define USB_ISTR_SUSP               0x0800
+#define USB_ISTR_RESET              0x0400
+#define USB_ISTR_SOF                0x0200
+#define USB_ISTR_ESOF               0x0100
+#define USB_ISTR_L1REQ              0x0080
+#define USB_ISTR_DIR                0x0010
+#define USB_ISTR_EP_ID              0x000F
+
+#define USB_FNR_FN                  0x07FF
+#define USB_DADDR_ADD               0x007F
+#define USB_DADDR_EF                0x0080
+
+#define USB_LPMCSR_LMPEN            0x0001
+#define USB_LPMCSR_LPMACK           0x0002
+#define USB_LPMCSR_REMWAKE          0x0008
+#define USB_LPMCSR_BESL             0x00F0
+
+#define USB_BCDR_BCDEN              0x0001
+#define USB_BCDR_DCDEN              0x0002
+#define USB_BCDR_PDEN               0x0004
+#define USB_BCDR_SDEN               0x0008
+#define USB_BCDR_DCDET              0x0010
+#define USB_BCDR_PDET               0x0020
+#define USB_BCDR_SDET               0x0040
+#define USB_BCDR_PS2DET             0x0080
+#define USB_BCDR_DPPU               0x8000
+
+/* Synopsys OTG core. The register space is mapped at the CMSIS base addresses by the OTG
+ * register model, see otg_model.h */
+typedef struct {
+    __IO uint32_t   GOTGCTL;
+    __IO uint32_t   GOTGINT;
+    __IO uint32_t   GAHBCFG;
+    __IO uint32_t   GUSBCFG;
+    __IO uint32_t   GRSTCTL;
+    __IO uint32_t   GINTSTS;
+    __IO uint32_t   GINTMSK;
+    __IO uint32_t   GRXSTSR;
+    __IO uint32_t   GRXSTSP;
+    __IO uint32_t   GRXFSIZ;
+    __IO uint32_t   DIEPTXF0_HNPTXFSIZ;
+    __IO uint32_t   HNPTXSTS;
+    uint32_t        Reserved30[2];
+    __IO uint32_t   GCCFG;
+    __IO uint32_t   CID;
+    __IO uint32_t   GSNPSID;
+    __IO uint32_t   GHWCFG1;
+    __IO uint32_t   GHWCFG2;
+    __IO uint32_t   GHWCFG3;
+    uint32_t        Reserved6;
+    __IO uint32_t   GLPMCFG;
+    __IO uint32_t   GPWRDN;
+    __IO uint32_t   GDFIFOCFG;
+    __IO uint32_t   GADPCTL;
+    uint32_t        Reserved43[39];
+    __IO uint32_t   HPTXFSIZ;
+    __IO uint32_t   DIEPTXF[0x0F];
+} USB_OTG_GlobalTypeDef;
+
+typedef struct {
+    __IO uint32_t   DCFG;
+    __IO uint32_t   DCTL;
+    __IO uint32_t   DSTS;
+    uint32_t        Reserved0C;
+    __IO uint32_t   DIEPMSK;
+    __IO uint32_t   DOEPMSK;
+    __IO uint32_t   DAINT;
+    __IO uint32_t   DAINTMSK;
+    uint32_t        Reserved20;
+    uint32_t        Reserved9;
+    __IO uint32_t   DVBUSDIS;
+    __IO uint32_t   DVBUSPULSE;
+    __IO uint32_t   DTHRCTL;
+    __IO uint32_t   DIEPEMPMSK;
+    __IO uint32_t   DEACHINT;
+    __IO uint32_t   DEACHMSK;
+} USB_OTG_DeviceTypeDef;
+
+typedef struct {
+    __IO uint32_t   DIEPCTL;
+    uint32_t        Reserved04;
+    __IO uint32_t   DIEPINT;
+    uint32_t        Reserved0C;
+    __IO uint32_t   DIEPTSIZ;
+    __IO uint32_t   DIEPDMA;
+    __IO uint32_t   DTXFSTS;
+    uint32_t        Reserved18;
+} USB_OTG_INEndpointTypeDef;
+
+typedef struct {
+    __IO uint32_t   DOEPCTL;
+    uint32_t        Reserved04;
+    __IO uint32_t   DOEPINT;
+    uint32_t        Reserved0C;
+    __IO uint32_t   DOEPTSIZ;
+    __IO uint32_t   DOEPDMA;
+    uint32_t        Reserved18[2];
+} USB_OTG_OUTEndpointTypeDef;
+
+#define USB_OTG_FS_PERIPH_BASE      0x50000000UL
+#define USB_OTG_HS_PERIPH_BASE      0x40040000UL
+#define USB_OTG_GLOBAL_BASE         0x0000UL
+#define USB_OTG_DEVICE_BASE         0x0800UL
+#define USB_OTG_IN_ENDPOINT_BASE    0x0900UL
+#define USB_OTG_OUT_ENDPOINT_BASE   0x0B00UL
+#define USB_OTG_EP_REG_SIZE         0x0020UL
+#define USB_OTG_PCGCCTL_BASE        0x0E00UL
+#define USB_OTG_FIFO_BASE           0x1000UL
+#define USB_OTG_FIFO_SIZE           0x1000UL
+
+#define USB_OTG_GOTGCTL_BVALOEN     (1U << 6)
+#define USB_OTG_GOTGCTL_BVALOVAL    (1U << 7)
+
+#define USB_OTG_GAHBCFG_GINT        (1U << 0)
+
+#define USB_OTG_GUSBCFG_TOCAL_Pos   0
+#define USB_OTG_GUSBCFG_TOCAL_Msk   (0x7U << USB_OTG_GUSBCFG_TOCAL_Pos)
+#define USB_OTG_GUSBCFG_PHYSEL      (1U << 6)
+#define USB_OTG_GUSBCFG_TRDT_Pos    10
+#define USB_OTG_GUSBCFG_TRDT_Msk    (0xFU << USB_OTG_GUSBCFG_TRDT_Pos)
+#define USB_OTG_GUSBCFG_FDMOD       (1U << 30)
+
+#define USB_OTG_GRSTCTL_CSRST       (1U << 0)
+#define USB_OTG_GRSTCTL_RXFFLSH     (1U << 4)
+#define USB_OTG_GRSTCTL_TXFFLSH     (1U << 5)
+#define USB_OTG_GRSTCTL_TXFNUM_Pos  6
+#define USB_OTG_GRSTCTL_TXFNUM_Msk  (0x1FU << USB_OTG_GRSTCTL_TXFNUM_Pos)
+#define USB_OTG_GRSTCTL_TXFNUM      USB_OTG_GRSTCTL_TXFNUM_Msk
+#define USB_OTG_GRSTCTL_AHBIDL      (1U << 31)
+
+#define USB_OTG_GINTSTS_SOF         (1U << 3)
+#define USB_OTG_GINTSTS_RXFLVL      (1U << 4)
+#define USB_OTG_GINTSTS_ESUSP       (1U << 10)
+#define USB_OTG_GINTSTS_USBSUSP     (1U << 11)
+#define USB_OTG_GINTSTS_USBRST      (1U << 12)
+#define USB_OTG_GINTSTS_ENUMDNE     (1U << 13)
+#define USB_OTG_GINTSTS_IEPINT      (1U << 18)
+#define USB_OTG_GINTSTS_OEPINT      (1U << 19)
+#define USB_OTG_GINTSTS_IISOIXFR    (1U << 20)
+#define USB_OTG_GINTSTS_PXFR_INCOMPISOOUT (1U << 21)
+#define USB_OTG_GINTSTS_LPMINT      (1U << 27)
+#define USB_OTG_GINTSTS_WKUINT      (1U << 31)
+
+#define USB_OTG_GINTMSK_SOFM        (1U << 3)
+#define USB_OTG_GINTMSK_RXFLVLM     (1U << 4)
+#define USB_OTG_GINTMSK_USBSUSPM    (1U << 11)
+#define USB_OTG_GINTMSK_USBRST      (1U << 12)
+#define USB_OTG_GINTMSK_ENUMDNEM    (1U << 13)
+#define USB_OTG_GINTMSK_IEPINT      (1U << 18)
+#define USB_OTG_GINTMSK_OEPINT      (1U << 19)
+#define USB_OTG_GINTMSK_IISOIXFRM   (1U << 20)
+#define USB_OTG_GINTMSK_PXFRM_IISOOXFRM (1U << 21)
+#define USB_OTG_GINTMSK_LPMINTM     (1U << 27)
+#define USB_OTG_GINTMSK_WUIM        (1U << 31)
+
+#define USB_OTG_GRXSTSP_EPNUM       0x0000000FU
+#define USB_OTG_GRXSTSP_BCNT_Pos    4
+#define USB_OTG_GRXSTSP_BCNT_Msk    (0x7FFU << USB_OTG_GRXSTSP_BCNT_Pos)
+#define USB_OTG_GRXSTSP_DPID_Pos    15
+#define USB_OTG_GRXSTSP_DPID_Msk    (0x3U << USB_OTG_GRXSTSP_DPID_Pos)
+#define USB_OTG_GRXSTSP_PKTSTS_Pos  17
+#define USB_OTG_GRXSTSP_PKTSTS_Msk  (0xFU << USB_OTG_GRXSTSP_PKTSTS_Pos)
+
+/* GCCFG of the legacy cores (F105, F4 up to F429) */
+#define USB_OTG_GCCFG_VBUSASEN      (1U << 18)
+#define USB_OTG_GCCFG_VBUSBSEN      (1U << 19)
+#define USB_OTG_GCCFG_SOFOUTEN      (1U << 20)
+#define USB_OTG_GCCFG_NOVBUSSENS    (1U << 21)
+/* GCCFG of the cores with BCD */
+#define USB_OTG_GCCFG_DCDET         (1U << 0)
+#define USB_OTG_GCCFG_PDET          (1U << 1)
+#define USB_OTG_GCCFG_SDET          (1U << 2)
+#define USB_OTG_GCCFG_PS2DET        (1U << 3)
+#define USB_OTG_GCCFG_PWRDWN        (1U << 16)
+#define USB_OTG_GCCFG_BCDEN         (1U << 17)
+#define USB_OTG_GCCFG_DCDEN         (1U << 18)
+#define USB_OTG_GCCFG_PDEN          (1U << 19)
+#define USB_OTG_GCCFG_SDEN          (1U << 20)
+#define USB_OTG_GCCFG_VBDEN         (1U << 21)
+
+#define USB_OTG_GLPMCFG_LPMEN       (1U << 0)
+#define USB_OTG_GLPMCFG_LPMACK      (1U << 1)
+#define USB_OTG_GLPMCFG_BESL_Pos    2
+#define USB_OTG_GLPMCFG_BESL_Msk    (0xFU << USB_OTG_GLPMCFG_BESL_Pos)
+#define USB_OTG_GLPMCFG_REMWAKE     (1U << 6)
+#define USB_OTG_GLPMCFG_L1SSEN      (1U << 7)
+#define USB_OTG_GLPMCFG_BESLTHRS_Pos 8
+#define USB_OTG_GLPMCFG_BESLTHRS_Msk (0xFU << USB_OTG_GLPMCFG_BESLTHRS_Pos)
+#define USB_OTG_GLPMCFG_L1DSEN      (1U << 12)
+#define USB_OTG_GLPMCFG_ENBESL      (1U << 28)
+
+#define USB_OTG_DCFG_DSPD_Pos       0
+#define USB_OTG_DCFG_DSPD_Msk       (0x3U << USB_OTG_DCFG_DSPD_Pos)
+#define USB_OTG_DCFG_DSPD           USB_OTG_DCFG_DSPD_Msk
+#define USB_OTG_DCFG_DAD_Pos        4
+#define USB_OTG_DCFG_DAD_Msk        (0x7FU << USB_OTG_DCFG_DAD_Pos)
+#define USB_OTG_DCFG_DAD            USB_OTG_DCFG_DAD_Msk
+#define USB_OTG_DCFG_PERSCHIVL_Pos  24
+#define USB_OTG_DCFG_PERSCHIVL_Msk  (0x3U << USB_OTG_DCFG_PERSCHIVL_Pos)
+#define USB_OTG_DCFG_PERSCHIVL      USB_OTG_DCFG_PERSCHIVL_Msk
+
+#define USB_OTG_DCTL_RWUSIG         (1U << 0)
+#define USB_OTG_DCTL_SDIS           (1U << 1)
+
+#define USB_OTG_DSTS_SUSPSTS        (1U << 0)
+#define USB_OTG_DSTS_ENUMSPD_Pos    1
+#define USB_OTG_DSTS_ENUMSPD_Msk    (0x3U << USB_OTG_DSTS_ENUMSPD_Pos)
+#define USB_OTG_DSTS_FNSOF_Pos      8
+#define USB_OTG_DSTS_FNSOF_Msk      (0x3FFFU << USB_OTG_DSTS_FNSOF_Pos)
+
+#define USB_OTG_DIEPMSK_XFRCM       (1U << 0)
+
+#define USB_OTG_DIEPCTL_MPSIZ_Pos   0
+#define USB_OTG_DIEPCTL_MPSIZ_Msk   (0x7FFU << USB_OTG_DIEPCTL_MPSIZ_Pos)
+#define USB_OTG_DIEPCTL_USBAEP      (1U << 15)
+#define USB_OTG_DIEPCTL_EONUM_DPID  (1U << 16)
+#define USB_OTG_DIEPCTL_NAKSTS      (1U << 17)
+#define USB_OTG_DIEPCTL_EPTYP       (0x3U << 18)
+#define USB_OTG_DIEPCTL_STALL       (1U << 21)
+#define USB_OTG_DIEPCTL_TXFNUM      (0xFU << 22)
+#define USB_OTG_DIEPCTL_CNAK        (1U << 26)
+#define USB_OTG_DIEPCTL_SNAK        (1U << 27)
+#define USB_OTG_DIEPCTL_SD0PID_SEVNFRM (1U << 28)
+#define USB_OTG_DIEPCTL_SODDFRM     (1U << 29)
+#define USB_OTG_DIEPCTL_EPDIS       (1U << 30)
+#define USB_OTG_DIEPCTL_EPENA       (1U << 31)
+
+#define USB_OTG_DOEPCTL_USBAEP      (1U << 15)
+#define USB_OTG_DOEPCTL_NAKSTS      (1U << 17)
+#define USB_OTG_DOEPCTL_EPTYP       (0x3U << 18)
+#define USB_OTG_DOEPCTL_STALL       (1U << 21)
+#define USB_OTG_DOEPCTL_CNAK        (1U << 26)
+#define USB_OTG_DOEPCTL_SNAK        (1U << 27)
+#define USB_OTG_DOEPCTL_SD0PID_SEVNFRM (1U << 28)
+#define USB_OTG_DOEPCTL_SODDFRM     (1U << 29)
+#define USB_OTG_DOEPCTL_EPDIS       (1U << 30)
+#define USB_OTG_DOEPCTL_EPENA       (1U << 31)
+
+#define USB_OTG_DIEPINT_XFRC        (1U << 0)
+#define USB_OTG_DIEPINT_EPDISD      (1U << 1)
+#define USB_OTG_DIEPINT_TXFE        (1U << 7)
+#define USB_OTG_DOEPINT_XFRC        (1U << 0)
+#define USB_OTG_DOEPINT_EPDISD      (1U << 1)
+#define USB_OTG_DOEPINT_STUP        (1U << 3)
+
+#define USB_OTG_DIEPTSIZ_XFRSIZ     0x0007FFFFU
+#define USB_OTG_DIEPTSIZ_PKTCNT_Pos 19
+#define USB_OTG_DIEPTSIZ_PKTCNT_Msk (0x3FFU << USB_OTG_DIEPTSIZ_PKTCNT_Pos)
+#define USB_OTG_DIEPTSIZ_PKTCNT     USB_OTG_DIEPTSIZ_PKTCNT_Msk
+#define USB_OTG_DIEPTSIZ_MULCNT_Pos 29
+#define USB_OTG_DIEPTSIZ_MULCNT_Msk (0x3U << USB_OTG_DIEPTSIZ_MULCNT_Pos)
+#define USB_OTG_DOEPTSIZ_XFRSIZ     0x0007FFFFU
+#define USB_OTG_DOEPTSIZ_PKTCNT_Pos 19
+#define USB_OTG_DOEPTSIZ_PKTCNT_Msk (0x3FFU << USB_OTG_DOEPTSIZ_PKTCNT_Pos)
+#define USB_OTG_DOEPTSIZ_PKTCNT     USB_OTG_DOEPTSIZ_PKTCNT_Msk
+#define USB_OTG_DOEPTSIZ_STUPCNT_Pos 29
+#define USB_OTG_DOEPTSIZ_STUPCNT_Msk (0x3U << USB_OTG_DOEPTSIZ_STUPCNT_Pos)
+
+#define USB_OTG_DTXFSTS_INEPTFSAV_Pos 0
+#define USB_OTG_DTXFSTS_INEPTFSAV_Msk (0xFFFFU << USB_OTG_DTXFSTS_INEPTFSAV_Pos)
+
+#define USB_OTG_PCGCCTL_STOPCLK     (1U << 0)
+#define USB_OTG_PCGCCTL_GATECLK     (1U << 1)
+
+#endif //_SIM_STM32_H_
@@ -0,0 +1,558 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <poll.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include "usbip_server.h"
+
+/* Protocol definitions follow the Linux Documentation/usb/usbip_protocol.rst */
+#define USBIP_VERSION       0x0111
+#define OP_REQ_DEVLIST      0x8005
+#define OP_REP_DEVLIST      0x0005
+#define OP_REQ_IMPORT       0x8003
+#define OP_REP_IMPORT       0x0003
+#define CMD_SUBMIT          0x0001
+#define CMD_UNLINK          0x0002
+#define RET_SUBMIT          0x0003
+#define RET_UNLINK          0x0004
+#define DIR_IN              0x0001
+#define SPEED_FULL          2
+#define SPEED_HIGH          3
+#define URB_SHORT_NOT_OK    0x0001
+#define URB_ZERO_PACKET     0x0040
+#define MAX_XFER            0x100000
+#define MAX_ISO_PACKETS     1024
+
+#define USBIP_BUSNUM        1
+
+struct op_header {
+    uint16_t    version;
+    uint16_t    code;
+    uint32_t    status;
+} __attribute__((packed));
+
+struct op_device {
+    char        path[256];
+    char        busid[32];
+    uint32_t    busnum;
+    uint32_t    devnum;
+    uint32_t    speed;
+    uint16_t    idVendor;
+    uint16_t    idProduct;
+    uint16_t    bcdDevice;
+    uint8_t     bDeviceClass;
+    uint8_t     bDeviceSubClass;
+    uint8_t     bDeviceProtocol;
+    uint8_t     bConfigurationValue;
+    uint8_t     bNumConfigurations;
+    uint8_t     bNumInterfaces;
+} __attribute__((packed));
+
+struct op_interface {
+    uint8_t     bInterfaceClass;
+    uint8_t     bInterfaceSubClass;
+    uint8_t     bInterfaceProtocol;
+    uint8_t     padding;
+} __attribute__((packed));
+
+struct urb_header {
+    uint32_t    command;
+    uint32_t    seqnum;
+    uint32_t    devid;
+    uint32_t    direction;
+    uint32_t    ep;
+    union {
+        struct {
+            uint32_t    flags;
+            uint32_t    length;
+            uint32_t    start_frame;
+            uint32_t    npkt;
+            uint32_t    interval;
+            uint8_t     setup[8];
+        } __attribute__((packed)) submit;
+        struct {
+            uint32_t    status;
+            uint32_t    actual;
+            uint32_t    start_frame;
+            uint32_t    npkt;
+            uint32_t    errors;
+            uint8_t     padding[8];
+        } __attribute__((packed)) ret;
+        struct {
+            uint32_t    seqnum;
+            uint8_t     padding[24];
+        } __attribute__((packed)) unlink;
+        struct {
+            uint32_t    status;
+            uint8_t     padding[24];
+        } __attribute__((packed)) ret_unlink;
+    };
+} __attribute__((packed));
+
+struct iso_desc {
+    uint32_t    offset;
+    uint32_t    length;
+    uint32_t    actual;
+    uint32_t    status;
+} __attribute__((packed));
+
+/* Pending URB. Fields are in the host byte order. */
+struct urb {
+    struct urb         *next;
+    uint32_t            seqnum;
+    uint32_t            flags;
+    uint8_t             ep;
+    uint8_t             setup[8];
+    bool                zlp;
+    uint32_t            len;
+    uint32_t            pos;
+    uint32_t            npkt;
+    struct iso_desc    *iso;
+    uint8_t            *buf;
+};
+
+static struct sim_host *host;
+static struct urb *queue;
+
+static bool read_full(int fd, void *buf, size_t len) {
+    uint8_t *p = buf;
+    while (len) {
+        ssize_t _t = read(fd, p, len);
+        if (_t < 0 && errno == EINTR) continue;
+        if (_t <= 0) return false;
+        p += _t;
+        len -= _t;
+    }
+    return true;
+}
+
+static bool write_full(int fd, const void *buf, size_t len) {
+    const uint8_t *p = buf;
+    while (len) {
+        ssize_t _t = write(fd, p, len);
+        if (_t < 0 && errno == EINTR) continue;
+        if (_t <= 0) return false;
+        p += _t;
+        len -= _t;
+    }
+    return true;
+}
+
+static void urb_free(struct urb *u) {
+    free(u->iso);
+    free(u->buf);
+    free(u);
+}
+
+static void queue_free(void) {
+    while (queue) {
+        struct urb *u = queue;
+        queue = u->next;
+        urb_free(u);
+    }
+}
+
+/** \brief Fills exported device info. Interfaces are taken from the first configuration. */
+static size_t device_info(struct op_device *d, struct op_interface *ifs, size_t max_ifs) {
+    const struct usb_config_descriptor *cfg = (const void*)host->config;
+    size_t n = 0;
+    memset(d, 0, sizeof(*d));
+    strncpy(d->path, "/sys/devices/platform/libusb_stm32/usb1/" USBIP_BUSID, sizeof(d->path) - 1);
+    strncpy(d->busid, USBIP_BUSID, sizeof(d->busid) - 1);
+    d->busnum = htonl(USBIP_BUSNUM);
+    d->devnum = htonl(USBIP_DEVADDR);
+    d->speed = htonl((host->frame_ns < 1000000) ? SPEED_HIGH : SPEED_FULL);
+    d->idVendor = htons(host->device.idVendor);
+    d->idProduct = htons(host->device.idProduct);
+    d->bcdDevice = htons(host->device.bcdDevice);
+    d->bDeviceClass = host->device.bDeviceClass;
+    d->bDeviceSubClass = host->device.bDeviceSubClass;
+    d->bDeviceProtocol = host->device.bDeviceProtocol;
+    d->bConfigurationValue = host->dev->status.device_cfg;
+    d->bNumConfigurations = host->device.bNumConfigurations;
+    d->bNumInterfaces = cfg->bNumInterfaces;
+    for (uint16_t pos = 0; pos + 2 <= host->config_len; pos += host->config[pos]) {
+        const struct usb_interface_descriptor *i = (const void*)&host->config[pos];
+        if (i->bLength < 2) break;
+        if (i->bDescriptorType != USB_DTYPE_INTERFACE || i->bLength < sizeof(*i)) continue;
+        if (i->bAlternateSetting != 0 || n >= max_ifs) continue;
+        ifs[n].bInterfaceClass = i->bInterfaceClass;
+        ifs[n].bInterfaceSubClass = i->bInterfaceSubClass;
+        ifs[n].bInterfaceProtocol = i->bInterfaceProtocol;
+        ifs[n].padding = 0;
+        n++;
+    }
+    return n;
+}
+
+/** \brief Maps host emulator result to the URB status */
+static int32_t urb_status(int res) {
+    switch (res) {
+    case SIM_STALL:
+        return -EPIPE;
+    case SIM_NAK:
+        return -ETIMEDOUT;
+    default:
+        return -EPROTO;
+    }
+}
+
+/** \brief Resets the device on the port reset request and restores it's address */
+static int port_reset(void) {
+    int res = sim_host_reset(host);
+    if (res < 0) return res;
+    host->mps[0][0] = host->mps[1][0] = host->device.bMaxPacketSize0;
+    return sim_host_control(host, USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE,
+                            USB_STD_SET_ADDRESS, USBIP_DEVADDR, 0, NULL, 0);
+}
+
+/** \brief Control URB. Always completes. */
+static int32_t urb_control(struct urb *u) {
+    usbd_ctlreq req;
+    int res;
+    memcpy(&req, u->setup, sizeof(req));
+    if (req.bmRequestType == (USB_REQ_HOSTTODEV | USB_REQ_STANDARD | USB_REQ_DEVICE) &&
+        req.bRequest == USB_STD_SET_ADDRESS) {
+        /* address is assigned by the server */
+        return 0;
+    }
+    if (req.bmRequestType == (USB_REQ_HOSTTODEV | USB_REQ_CLASS | USB_REQ_OTHER) &&
+        req.bRequest == USB_STD_SET_FEATURE && req.wValue == 4 /* PORT_RESET */) {
+        res = port_reset();
+        return (res < 0) ? urb_status(res) : 0;
+    }
+    res = sim_host_control(host, req.bmRequestType, req.bRequest, req.wValue, req.wIndex,
+                           u->buf, (req.wLength < u->len) ? req.wLength : u->len);
+    if (res < 0) return urb_status(res);
+    u->pos = res;
+    return 0;
+}
+
+/** \brief Isochronous URB. One packet per frame, always completes. */
+static int32_t urb_iso(struct urb *u, uint32_t *errors) {
+    uint32_t pos = 0;
+    for (uint32_t i = 0; i < u->npkt; i++) {
+        struct iso_desc *d = &u->iso[i];
+        int res;
+        if (d->offset > u->len || d->length > u->len - d->offset || d->length > 0xFFFF) {
+            d->status = -EINVAL;
+            (*errors)++;
+            continue;
+        }
+        if (u->ep & 0x80) {
+            res = sim_host_iso_read(host, u->ep, &u->buf[d->offset], d->length);
+        } else {
+            res = sim_host_iso_write(host, u->ep, &u->buf[d->offset], d->length);
+        }
+        if (res < 0) {
+            d->actual = 0;
+            d->status = (res == SIM_NORESP) ? -EXDEV : urb_status(res);
+            (*errors)++;
+        } else {
+            d->actual = res;
+            d->status = 0;
+            pos += res;
+        }
+    }
+    u->pos = pos;
+    return 0;
+}
+
+/** \brief Bulk or interrupt URB. Transfers packets until NAK.
+ * \return 1 if the URB is still pending, 0 or negative status if completed
+ */
+static int32_t urb_data(struct urb *u) {
+    const uint16_t mps = host->mps[u->ep >> 7][u->ep & 0x0F];
+    const uint32_t timeout = host->timeout;
+    int32_t status = 1;
+    if (mps == 0) return -EPIPE;
+    /* one attempt per call, NAKed URB is retried by the next call */
+    host->timeout = 0;
+    while (status == 1) {
+        uint32_t _t = u->len - u->pos;
+        int res;
+        if (_t > mps) _t = mps;
+        if (u->ep & 0x80) {
+            res = sim_host_read(host, u->ep, &u->buf[u->pos], _t);
+        } else if (_t == 0 && u->pos && !u->zlp) {
+            /* last packet was full, no ZLP required */
+            status = 0;
+            break;
+        } else {
+            res = sim_host_write(host, u->ep, &u->buf[u->pos], _t, false);
+        }
+        if (res == SIM_NAK) break;
+        if (res < 0) {
+            status = urb_status(res);
+        } else {
+            u->pos += res;
+            if (res < mps) {
+                /* short packet or ZLP completes the transfer */
+                status = ((u->ep & 0x80) && (u->flags & URB_SHORT_NOT_OK) &&
+                          (u->pos < u->len)) ? -EREMOTEIO : 0;
+            } else if ((u->ep & 0x80) && u->pos == u->len) {
+                status = 0;
+            }
+        }
+    }
+    host->timeout = timeout;
+    return status;
+}
+
+static bool send_ret_submit(int fd, struct urb *u, int32_t status, uint32_t errors) {
+    struct urb_header h;
+    const bool in = (u->ep & 0x80) != 0;
+    memset(&h, 0, sizeof(h));
+    h.command = htonl(RET_SUBMIT);
+    h.seqnum = htonl(u->seqnum);
+    h.ret.status = htonl((uint32_t)status);
+    h.ret.actual = htonl(u->pos);
+    h.ret.start_frame = htonl(host->frame);
+    h.ret.npkt = htonl(u->npkt);
+    h.ret.errors = htonl(errors);
+    if (!write_full(fd, &h, sizeof(h))) return false;
+    if (in && u->iso) {
+        /* isochronous IN data is sent packed by the actual lengths */
+        for (uint32_t i = 0; i < u->npkt; i++) {
+            if (!write_full(fd, &u->buf[u->iso[i].offset], u->iso[i].actual)) return false;
+        }
+    } else if (in && u->pos) {
+        if (!write_full(fd, u->buf, u->pos)) return false;
+    }
+    for (uint32_t i = 0; i < u->npkt; i++) {
+        struct iso_desc d = {
+            .offset = htonl(u->iso[i].offset),
+            .length = htonl(u->iso[i].length),
+            .actual = htonl(u->iso[i].actual),
+            .status = htonl(u->iso[i].status),
+        };
+        if (!write_full(fd, &d, sizeof(d))) return false;
+    }
+    return true;
+}
+
+/** \brief Processes the pending URBs. First URB of each endpoint only.
+ * \return number of completed URBs or -1 on the socket error
+ */
+static int process_queue(int fd) {
+    uint32_t busy = 0;
+    int done = 0;
+    for (struct urb **pu = &queue; *pu; ) {
+        struct urb *u = *pu;
+        const uint32_t pipe = 1UL << ((u->ep & 0x0F) + ((u->ep & 0x80) ? 16 : 0));
+        uint32_t errors = 0;
+        int32_t status;
+        if (busy & pipe) {
+            pu = &u->next;
+            continue;
+        }
+        if ((u->ep & 0x0F) == 0) {
+            status = urb_control(u);
+        } else if (u->iso) {
+            status = urb_iso(u, &errors);
+        } else {
+            status = urb_data(u);
+        }
+        if (status == 1) {
+            busy |= pipe;
+            pu = &u->next;
+            continue;
+        }
+        *pu = u->next;
+        if (!send_ret_submit(fd, u, status, errors)) {
+            urb_free(u);
+            return -1;
+        }
+        urb_free(u);
+        done++;
+    }
+    return done;
+}
+
+static bool cmd_submit(int fd, const struct urb_header *h) {
+    struct urb *u = calloc(1, sizeof(*u));
+    const uint32_t ep = ntohl(h->ep);
+    const uint32_t npkt = ntohl(h->submit.npkt);
+    if (!u) return false;
+    u->seqnum = ntohl(h->seqnum);
+    u->flags = ntohl(h->submit.flags);
+    u->ep = (ep & 0x0F) | ((ntohl(h->direction) == DIR_IN) ? 0x80 : 0x00);
+    u->len = ntohl(h->submit.length);
+    u->zlp = (u->flags & URB_ZERO_PACKET) != 0;
+    memcpy(u->setup, h->submit.setup, sizeof(u->setup));
+    if (u->len > MAX_XFER || !(u->buf = calloc(1, u->len ? u->len : 1))) {
+        urb_free(u);
+        return false;
+    }
+    if (!(u->ep & 0x80) && u->len && !read_full(fd, u->buf, u->len)) {
+        urb_free(u);
+        return false;
+    }
+    if (host->type[(u->ep >> 7)][u->ep & 0x0F] == USB_EPTYPE_ISOCHRONUS &&
+        npkt != 0 && npkt != 0xFFFFFFFF) {
+        if (npkt > MAX_ISO_PACKETS || !(u->iso = calloc(npkt, sizeof(*u->iso))) ||
+            !read_full(fd, u->iso, npkt * sizeof(*u->iso))) {
+            urb_free(u);
+            return false;
+        }
+        u->npkt = npkt;
+        for (uint32_t i = 0; i < npkt; i++) {
+            u->iso[i].offset = ntohl(u->iso[i].offset);
+            u->iso[i].length = ntohl(u->iso[i].length);
+            u->iso[i].actual = 0;
+            u->iso[i].status = 0;
+        }
+    }
+    /* keep the arrival order */
+    struct urb **pu = &queue;
+    while (*pu) pu = &(*pu)->next;
+    *pu = u;
+    return true;
+}
+
+static bool cmd_unlink(int fd, const struct urb_header *h) {
+    const uint32_t seqnum = ntohl(h->unlink.seqnum);
+    struct urb_header r;
+    int32_t status = 0;
+    for (struct urb **pu = &queue; *pu; pu = &(*pu)->next) {
+        if ((*pu)->seqnum == seqnum) {
+            struct urb *u = *pu;
+            *pu = u->next;
+            urb_free(u);
+            status = -ECONNRESET;
+            break;
+        }
+    }
+    memset(&r, 0, sizeof(r));
+    r.command = htonl(RET_UNLINK);
+    r.seqnum = h->seqnum;
+    r.ret_unlink.status = htonl((uint32_t)status);
+    return write_full(fd, &r, sizeof(r));
+}
+
+/** \brief Serves the imported device until the client disconnects */
+static void serve_urbs(int fd) {
+    for (;;) {
+        struct pollfd p = {.fd = fd, .events = POLLIN};
+        struct urb_header h;
+        int done = process_queue(fd);
+        if (done < 0) break;
+        int res = poll(&p, 1, done ? 0 : 1);
+        if (res < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        if (res == 0) {
+            /* idle. next frame for the pending interrupt and NAKed bulk URBs */
+            if (!done) sim_host_frames(host, 1, true);
+            continue;
+        }
+        if (!read_full(fd, &h, sizeof(h))) break;
+        if (ntohl(h.command) == CMD_SUBMIT) {
+            if (!cmd_submit(fd, &h)) break;
+        } else if (ntohl(h.command) == CMD_UNLINK) {
+            if (!cmd_unlink(fd, &h)) break;
+        } else {
+            break;
+        }
+    }
+    queue_free();
+}
+
+static void serve_client(int fd) {
+    struct op_header req, rep;
+    struct op_device dev;
+    struct op_interface ifs[32];
+    char busid[32];
+    size_t n;
+
+    if (!read_full(fd, &req, sizeof(req))) return;
+    if (ntohs(req.version) != USBIP_VERSION) return;
+    rep.version = htons(USBIP_VERSION);
+    rep.status = 0;
+    switch (ntohs(req.code)) {
+    case OP_REQ_DEVLIST: {
+        uint32_t ndev = htonl(1);
+        rep.code = htons(OP_REP_DEVLIST);
+        n = device_info(&dev, ifs, sizeof(ifs) / sizeof(ifs[0]));
+        dev.bNumInterfaces = n;
+        if (write_full(fd, &rep, sizeof(rep)) && write_full(fd, &ndev, sizeof(ndev)) &&
+            write_full(fd, &dev, sizeof(dev))) {
+            write_full(fd, ifs, n * sizeof(ifs[0]));
+        }
+        break;
+    }
+    case OP_REQ_IMPORT:
+        if (!read_full(fd, busid, sizeof(busid))) return;
+        busid[sizeof(busid) - 1] = '\0';
+        rep.code = htons(OP_REP_IMPORT);
+        if (strcmp(busid, USBIP_BUSID) != 0) {
+            rep.status = htonl(1);
+            write_full(fd, &rep, sizeof(rep));
+            break;
+        }
+        device_info(&dev, ifs, 0);
+        if (write_full(fd, &rep, sizeof(rep)) && write_full(fd, &dev, sizeof(dev))) {
+            serve_urbs(fd);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+int usbip_server_run(struct sim_host *h, uint16_t port) {
+    struct sockaddr_in sa = {
+        .sin_family = AF_INET,
+        .sin_port = htons(port),
+        .sin_addr.s_addr = htonl(INADDR_LOOPBACK),
+    };
+    const int one = 1;
+    int res, lfd;
+
+    host = h;
+    res = sim_host_probe(host, USBIP_DEVADDR);
+    if (res < 0) return -ENODEV;
+    lfd = socket(AF_INET, SOCK_STREAM, 0);
+    if (lfd < 0) return -errno;
+    setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    if (bind(lfd, (struct sockaddr*)&sa, sizeof(sa)) < 0 || listen(lfd, 1) < 0) {
+        res = -errno;
+        close(lfd);
+        return res;
+    }
+    for (;;) {
+        int fd = accept(lfd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            res = -errno;
+            break;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        serve_client(fd);
+        close(fd);
+    }
+    close(lfd);
+    return res;
+}
@@ -0,0 +1,59 @@
+/* This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+ *
+ * Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _USBIP_SERVER_H_
+#define _USBIP_SERVER_H_
+#if defined(__cplusplus)
+    extern "C" {
+#endif
+
+#include <stdint.h>
+#include "sim_host.h"
+
+/**\addtogroup SIM_USBIP USB/IP server
+ * \brief Exports the simulated device over the USB/IP protocol.
+ * \details The server listens on the loopback interface and exports one device with the bus id
+ * \ref USBIP_BUSID. URBs submitted by the Linux vhci_hcd are translated to the \ref SIM_HOST
+ * transfers, so the real host class drivers (cdc_acm, usbhid, usb-storage, cdc_ncm etc.) can
+ * talk to the device stack running on the register model.
+ * \code
+ * sudo modprobe vhci-hcd
+ * sudo usbip attach -r 127.0.0.1 -b 1-1
+ * \endcode
+ * Requests are served in the arrival order per endpoint. NAKed bulk and interrupt URBs are kept
+ * pending and retried each frame (1ms of the real time while idle) until completed or unlinked.
+ * SET_ADDRESS is completed locally, port reset from the host resets the bus and restores the
+ * address.
+ * @{ */
+
+#define USBIP_PORT      3240        /**<\brief Default USB/IP TCP port.*/
+#define USBIP_BUSID     "1-1"       /**<\brief Exported device bus id.*/
+#define USBIP_DEVADDR   2           /**<\brief Address assigned to the device.*/
+
+/**\brief Runs USB/IP server
+ * \details Probes the device (see \ref sim_host_probe) and serves clients one by one. Doesn't
+ * return until the socket error.
+ * \param host pointer to the initialized host emulator
+ * \param port TCP port to listen
+ * \return negative errno value
+ */
+int usbip_server_run(struct sim_host *host, uint16_t port);
+
+/** @} */
+
+#if defined(__cplusplus)
+    }
+#endif
+#endif //_USBIP_SERVER_H_
@@ -0,0 +1,134 @@
+#!/usr/bin/env python3
+# This file is the part of the Lightweight USB device Stack for STM32 microcontrollers
+#
+# Copyright ©2016 Dmitry Filimonchuk <dmitrystu[at]gmail[dot]com>
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#   http://www.apache.org/licenses/LICENSE-2.0
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Decodes USBD_TRACE ring from the RAM dump.
+
+Dump the `usbd_trace` symbol (or the whole RAM) from the target, i.e.
+    (gdb) dump binary value trace.bin usbd_trace
+    st-flash read trace.bin 0x20000000 0x5000
+and run
+    usbd_trace.py trace.bin --clock 72000000 --hist
+"""
+
+import argparse
+import struct
+import sys
+
+MAGIC = 0x43525455
+HEADER = struct.Struct('<III')
+RECORD = struct.Struct('<IBBH')
+
+EVENTS = ['reset', 'sof', 'susp', 'wkup', 'eptx', 'eprx', 'epsetup', 'error',
+          'l1susp', 'l1wkup', 'isoinc']
+CTL_STATES = ['idle', 'rxdata', 'txdata', 'ztxdata', 'lastdata', 'statusin',
+              'statusout', 'deferred']
+TYPES = {1: 'EVT', 2: 'CTL', 3: 'RD', 4: 'WR'}
+EP_EVENTS = (4, 5, 6, 10)
+
+
+def name(table, idx):
+    return table[idx] if idx < len(table) else str(idx)
+
+
+def load(data):
+    """Returns trace records in the chronological order."""
+    pos = data.find(struct.pack('<I', MAGIC))
+    while pos >= 0:
+        _, size, head = HEADER.unpack_from(data, pos)
+        end = pos + HEADER.size + size * RECORD.size
+        if size and not (size & (size - 1)) and end <= len(data):
+            count = min(head, size)
+            recs = []
+            for n in range(head - count, head):
+                off = pos + HEADER.size + (n & (size - 1)) * RECORD.size
+                recs.append(RECORD.unpack_from(data, off))
+            return recs, head - count
+        pos = data.find(struct.pack('<I', MAGIC), pos + 1)
+    raise ValueError('trace ring not found')
+
+
+def describe(rtype, ep, arg):
+    if rtype == 1:
+        return '%-8s state=%s' % (name(EVENTS, arg & 0xFF), name(CTL_STATES, arg >> 8))
+    if rtype == 2:
+        return '-> %s' % name(CTL_STATES, arg)
+    if rtype in (3, 4):
+        return '%d' % (arg - 0x10000 if arg & 0x8000 else arg)
+    return 'arg=0x%04X' % arg
+
+
+def histogram(title, values, unit):
+    print('\n%s (%d samples)' % (title, len(values)))
+    if not values:
+        return
+    buckets = {}
+    for v in values:
+        b = max(v, 1).bit_length() - 1
+        buckets[b] = buckets.get(b, 0) + 1
+    top = max(buckets.values())
+    for b in sorted(buckets):
+        lo, hi = 1 << b, (2 << b) - 1
+        print('  %10s..%-10s %6d %s' % (unit(lo), unit(hi), buckets[b],
+                                      '#' * max(1, buckets[b] * 40 // top)))
+    print('  min %s  max %s' % (unit(min(values)), unit(max(values))))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='USBD_TRACE ring decoder')
+    parser.add_argument('dump', help='binary RAM dump with the usbd_trace ring')
+    parser.add_argument('--clock', type=float, default=0,
+                        help='timestamp clock in Hz. Times are shown in ticks if omitted')
+    parser.add_argument('--hist', action='store_true',
+                        help='print latency histograms')
+    parser.add_argument('--quiet', action='store_true', help='do not print timeline')
+    args = parser.parse_args()
+
+    with open(args.dump, 'rb') as f:
+        recs, first = load(f.read())
+
+    if args.clock:
+        unit = lambda t: '%.2fus' % (t * 1e6 / args.clock)
+    else:
+        unit = lambda t: '%d' % t
+
+    service = []    # endpoint event to the first read/write of this endpoint
+    handling = []   # EP0 event to the control stage update
+    pending = {}
+    ep0 = None
+    prev = None
+    for n, (tick, rtype, ep, arg) in enumerate(recs):
+        delta = 0 if prev is None else (tick - prev) & 0xFFFFFFFF
+        prev = tick
+        if not args.quiet:
+            print('%8d %12s  +%-10s %-3s ep=0x%02X %s' % (first + n, unit(tick), unit(delta),
+                  TYPES.get(rtype, rtype), ep, describe(rtype, ep, arg)))
+        if rtype == 1 and (arg & 0xFF) in EP_EVENTS:
+            pending[ep & 0x7F] = tick
+            if (ep & 0x7F) == 0:
+                ep0 = tick
+        elif rtype in (3, 4) and (ep & 0x7F) in pending:
+            service.append((tick - pending.pop(ep & 0x7F)) & 0xFFFFFFFF)
+        elif rtype == 2 and ep0 is not None:
+            handling.append((tick - ep0) & 0xFFFFFFFF)
+            ep0 = None
+
+    if args.hist:
+        histogram('Endpoint event to read/write latency', service, unit)
+        histogram('EP0 event handling time', handling, unit)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())